@@ -0,0 +1,76 @@
+#ifndef _MAKENA_BENCH_COMMON_HPP_
+#define _MAKENA_BENCH_COMMON_HPP_
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "primitives.hpp"
+
+/**
+ * @file bench_common.hpp
+ *
+ * @brief small helpers shared by the benchmark programs in this directory.
+ */
+namespace Makena {
+
+/** @brief default location of the demo models relative to Voxcell/Benchmarks.
+ */
+[[maybe_unused]] static const char* BENCH_MODEL_DIR = "../../VoxcellDemo/Shared/Models/";
+
+
+/** @brief loads the vertex positions ('v' lines) from a Wavefront OBJ file.
+ *
+ *  @param  path (in): path to the OBJ file.
+ *
+ *  @return the vertex positions in the order they appear in the file.
+ */
+static inline std::vector<Vec3> benchLoadObjVertices(const std::string& path)
+{
+    std::vector<Vec3> points;
+    std::ifstream     is(path);
+    std::string       line;
+
+    while (std::getline(is, line)) {
+        if (line.size() > 2 && line[0] == 'v' && line[1] == ' ') {
+            double x, y, z;
+            if (sscanf(line.c_str() + 2, "%lf %lf %lf", &x, &y, &z) == 3) {
+                points.emplace_back(x, y, z);
+            }
+        }
+    }
+    return points;
+}
+
+
+/** @brief returns the current time of the steady clock in milliseconds.
+ */
+static inline double benchNowMs()
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/** @brief runs func() the given number of times and returns the
+ *         minimum elapsed time in milliseconds.
+ */
+template<class F>
+static inline double benchMinMs(const int repeat, F func)
+{
+    double best = 1.0e300;
+    for (int i = 0; i < repeat; i++) {
+        auto t0 = benchNowMs();
+        func();
+        auto t1 = benchNowMs();
+        best = std::min(best, t1 - t0);
+    }
+    return best;
+}
+
+
+}// namespace Makena
+
+#endif/*_MAKENA_BENCH_COMMON_HPP_*/
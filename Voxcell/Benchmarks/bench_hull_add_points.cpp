@@ -0,0 +1,114 @@
+/**
+ * @file bench_hull_add_points.cpp
+ *
+ * @brief checks the vertex IDs and measures the time per batch of
+ *        Manifold::addPoints() on hulls of different sizes.
+ *
+ *        The check builds a hull by findConvexHull() and adds points to
+ *        it by addPoints() with the automatic IDs, and then reports if
+ *        the IDs of the vertices are unique. It returns 1 if not.
+ *
+ *        The benchmark adds batches of 100 points near the unit sphere
+ *        to the hull of the points on it, and reports the time per batch.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <random>
+#include <set>
+
+#include "manifold.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static std::vector<Vec3> spherePoints(
+    std::mt19937_64& engine,
+    const long       numPoints,
+    const double     radius
+) {
+    std::normal_distribution<double> dist;
+    std::vector<Vec3>                points;
+    for (long i = 0; i < numPoints; i++) {
+        Vec3 v(dist(engine), dist(engine), dist(engine));
+        v.normalize();
+        points.push_back(v * radius);
+    }
+    return points;
+}
+
+
+static bool checkUniqueIds()
+{
+    std::mt19937_64 engine(1);
+    Manifold        hull;
+    enum predicate  pred;
+
+    auto points = spherePoints(engine, 100, 1.0);
+    hull.findConvexHull(points, pred);
+
+    auto added = spherePoints(engine, 100, 1.01);
+    hull.addPoints(added, pred);
+
+    auto addedAgain = spherePoints(engine, 100, 1.02);
+    hull.addPoints(addedAgain, pred);
+
+    std::set<long> ids;
+    long           numVertices = 0;
+    auto vPair = hull.vertices();
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        ids.insert((*vit)->id());
+        numVertices++;
+    }
+
+    printf("findConvexHull() + addPoints(): %ld vertices, %ld distinct IDs\n",
+           numVertices, (long)ids.size());
+    return (long)ids.size() == numVertices;
+}
+
+
+int main()
+{
+    if (!checkUniqueIds()) {
+        printf("FAILED: the vertex IDs are not unique\n");
+        return 1;
+    }
+
+    const long numBatches = 20;
+
+    for (long numPoints : { 1000, 10000, 100000 }) {
+
+        std::mt19937_64 engine(2);
+        Manifold        hull;
+        enum predicate  pred;
+
+        auto points = spherePoints(engine, numPoints, 1.0);
+        hull.findConvexHull(points, pred);
+        auto fPair = hull.faces();
+        long numFaces = std::distance(fPair.first, fPair.second);
+
+        // Most of the points are inside, and a few are just outside.
+        std::vector<std::vector<Vec3>> batches;
+        std::uniform_real_distribution<double> radius(0.5, 1.0005);
+        for (long i = 0; i < numBatches; i++) {
+            std::vector<Vec3> batch;
+            for (long j = 0; j < 100; j++) {
+                auto p = spherePoints(engine, 1, radius(engine));
+                batch.push_back(p[0]);
+            }
+            batches.push_back(batch);
+        }
+
+        auto t0 = benchNowMs();
+        for (auto& batch : batches) {
+            hull.addPoints(batch, pred);
+        }
+        auto t1 = benchNowMs();
+
+        printf("hull of %6ld points (%6ld faces): %9.4f ms per batch "
+               "of 100 points\n",
+               numPoints, numFaces, (t1 - t0) / numBatches);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file bench_hull_insertion_order.cpp
+ *
+ * @brief compares INSERTION_ORDER_SHUFFLED and INSERTION_ORDER_INPUT of
+ *        Manifold::findConvexHull() on sorted inputs.
+ *
+ *        The inputs are:
+ *        - the shell voxels of a ball in scanline (z, y, x) order,
+ *        - the vertices of the demo meshes sorted by (x, y, z),
+ *        - points on a sphere sorted by z.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <algorithm>
+#include <random>
+
+#include "manifold.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static std::vector<Vec3> ballShellVoxels(const int radius)
+{
+    std::vector<Vec3> points;
+    const double r2Out = (double)radius * radius;
+    const double r2In  = (double)(radius - 1) * (radius - 1);
+
+    for (int z = -radius; z <= radius; z++) {
+        for (int y = -radius; y <= radius; y++) {
+            for (int x = -radius; x <= radius; x++) {
+                double d2 = (double)x*x + (double)y*y + (double)z*z;
+                if (d2 <= r2Out && d2 > r2In) {
+                    points.emplace_back(x, y, z);
+                }
+            }
+        }
+    }
+    return points;
+}
+
+
+static std::vector<Vec3> sortedSphere(const long n)
+{
+    std::mt19937_64                        engine(1);
+    std::normal_distribution<double>       dist;
+    std::vector<Vec3>                      points;
+
+    for (long i = 0; i < n; i++) {
+        Vec3 v(dist(engine), dist(engine), dist(engine));
+        v.normalize();
+        points.push_back(v);
+    }
+    std::sort(points.begin(), points.end(),
+              [](const Vec3& a, const Vec3& b){ return a.z() < b.z(); });
+    return points;
+}
+
+
+static void run(const char* name, std::vector<Vec3>& points)
+{
+    const int repeat = 3;
+
+    long numVertices = 0;
+
+    auto tInput = benchMinMs(repeat, [&]{
+        Manifold       m;
+        enum predicate pred;
+        m.setInsertionOrder(Manifold::INSERTION_ORDER_INPUT);
+        m.findConvexHull(points, pred);
+        auto vp = m.vertices();
+        numVertices = std::distance(vp.first, vp.second);
+    });
+
+    auto tShuffled = benchMinMs(repeat, [&]{
+        Manifold       m;
+        enum predicate pred;
+        m.setInsertionOrder(Manifold::INSERTION_ORDER_SHUFFLED);
+        m.findConvexHull(points, pred);
+    });
+
+    printf("%-22s n=%8zu  hull V=%6ld  input: %10.2f ms  "
+           "shuffled: %10.2f ms  ratio: %6.2f\n",
+           name, points.size(), numVertices, tInput, tShuffled,
+           tInput / tShuffled);
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string modelDir = (argc > 1) ? argv[1] : BENCH_MODEL_DIR;
+
+    auto ball = ballShellVoxels(40);
+    run("ball shell voxels", ball);
+
+    for (auto name : { "duck_smoothed.obj", "spot_smoothed.obj" }) {
+        auto points = benchLoadObjVertices(modelDir + name);
+        if (points.empty()) {
+            printf("%-22s not found in %s\n", name, modelDir.c_str());
+            continue;
+        }
+        std::sort(points.begin(), points.end(),
+                  [](const Vec3& a, const Vec3& b) {
+                      if (a.x() != b.x()) return a.x() < b.x();
+                      if (a.y() != b.y()) return a.y() < b.y();
+                      return a.z() < b.z();
+                  });
+        run(name, points);
+    }
+
+    auto sphere = sortedSphere(20000);
+    run("sorted sphere", sphere);
+
+    return 0;
+}
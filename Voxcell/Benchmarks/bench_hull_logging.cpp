@@ -0,0 +1,87 @@
+/**
+ * @file bench_hull_logging.cpp
+ *
+ * @brief measures the cost of the logging calls left in the incremental
+ *        loop of Manifold::findConvexHull() with the log level OFF at
+ *        runtime.
+ *
+ *        Build it twice and compare the two outputs:
+ *        - as is, where all the levels are compiled in and each call
+ *          checks the runtime level,
+ *        - with -DMAKENA_MAX_LOG_LEVEL=0, where the calls are removed at
+ *          compile time.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <random>
+
+#include "manifold.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static std::vector<Vec3> sphere(const long n)
+{
+    std::mt19937_64                        engine(1);
+    std::normal_distribution<double>       dist;
+    std::vector<Vec3>                      points;
+
+    for (long i = 0; i < n; i++) {
+        Vec3 v(dist(engine), dist(engine), dist(engine));
+        v.normalize();
+        points.push_back(v);
+    }
+    return points;
+}
+
+
+static void run(const char* name, std::vector<Vec3>& points)
+{
+    const int repeat = 5;
+
+    for (auto mode : { Manifold::CONFLICT_LISTS, Manifold::CONFLICT_GRAPH }) {
+
+        long numVertices = 0;
+
+        auto t = benchMinMs(repeat, [&]{
+            Manifold       m;
+            enum predicate pred;
+            m.setLogLevel(Loggable::OFF);
+            m.setConflictTrackingMode(mode);
+            m.findConvexHull(points, pred);
+            auto vp = m.vertices();
+            numVertices = std::distance(vp.first, vp.second);
+        });
+
+        printf("%-20s %-6s n=%8zu  hull V=%6ld  %10.2f ms  %8.1f ns/point\n",
+               name, (mode == Manifold::CONFLICT_LISTS) ? "lists" : "graph",
+               points.size(), numVertices, t, t * 1.0e6 / points.size());
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string modelDir = (argc > 1) ? argv[1] : BENCH_MODEL_DIR;
+
+    printf("MAKENA_MAX_LOG_LEVEL=%d (%s)\n", MAKENA_MAX_LOG_LEVEL,
+           (MAKENA_MAX_LOG_LEVEL == 0) ? "compiled out" : "runtime OFF");
+
+    for (auto name : { "duck_smoothed.obj", "spot_smoothed.obj" }) {
+        auto points = benchLoadObjVertices(modelDir + name);
+        if (points.empty()) {
+            printf("%-20s not found in %s\n", name, modelDir.c_str());
+            continue;
+        }
+        run(name, points);
+    }
+
+    auto s1 = sphere(2000);
+    run("sphere", s1);
+
+    auto s2 = sphere(20000);
+    run("sphere", s2);
+
+    return 0;
+}
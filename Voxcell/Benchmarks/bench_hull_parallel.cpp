@@ -0,0 +1,105 @@
+/**
+ * @file bench_hull_parallel.cpp
+ *
+ * @brief compares Manifold::findConvexHull() with
+ *        Manifold::findConvexHullParallel() on points on a sphere, in a
+ *        ball, and in a cube.
+ *
+ *        It reports the time of each and the numbers of the hull vertices,
+ *        and returns 1 if the numbers differ.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <random>
+#include <thread>
+
+#include "manifold.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static std::vector<Vec3> makePoints(
+    std::mt19937_64& engine,
+    const long       numPoints,
+    const int        shape
+) {
+    std::normal_distribution<double>       normal;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<Vec3>                      points;
+    while ((long)points.size() < numPoints) {
+        if (shape == 0) {
+            Vec3 v(normal(engine), normal(engine), normal(engine));
+            v.normalize();
+            points.push_back(v);
+        }
+        else {
+            Vec3 v(uniform(engine), uniform(engine), uniform(engine));
+            if (shape == 2 || v.squaredNorm2() <= 1.0) {
+                points.push_back(v);
+            }
+        }
+    }
+    return points;
+}
+
+
+static long numVertices(Manifold& m)
+{
+    long num   = 0;
+    auto vPair = m.vertices();
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        num++;
+    }
+    return num;
+}
+
+
+int main()
+{
+    // At least 4 to run the partitions even on a machine with fewer cores.
+    const long  numThreads = std::max(4u, std::thread::hardware_concurrency());
+    const char* shapes[]   = { "sphere", "ball", "cube" };
+    bool        ok         = true;
+
+    printf("%ld threads\n", numThreads);
+
+    for (int shape = 0; shape < 3; shape++) {
+        for (long numPoints : { 50000, 200000 }) {
+
+            std::mt19937_64 engine(shape * 10 + 1);
+            auto points = makePoints(engine, numPoints, shape);
+
+            enum predicate pred;
+            long           seqVertices = 0;
+            long           parVertices = 0;
+
+            auto seqMs = benchMinMs(3, [&]{
+                Manifold m;
+                m.findConvexHull(points, pred);
+                seqVertices = numVertices(m);
+            });
+
+            auto parMs = benchMinMs(3, [&]{
+                Manifold m;
+                m.findConvexHullParallel(points, pred, numThreads);
+                parVertices = numVertices(m);
+            });
+
+            printf("%-6s %6ld points: sequential %9.2f ms (%ld vertices), "
+                   "parallel %9.2f ms (%ld vertices)\n",
+                   shapes[shape], numPoints, seqMs, seqVertices,
+                   parMs, parVertices);
+
+            if (seqVertices != parVertices) {
+                ok = false;
+            }
+        }
+    }
+
+    if (!ok) {
+        printf("FAILED: the numbers of the hull vertices differ\n");
+        return 1;
+    }
+    return 0;
+}
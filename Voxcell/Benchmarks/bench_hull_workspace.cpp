@@ -0,0 +1,124 @@
+/**
+ * @file bench_hull_workspace.cpp
+ *
+ * @brief counts the heap allocations and measures the time per call of
+ *        back-to-back Manifold::findConvexHull() on small point sets
+ *        with one Manifold reused by clear(), for each combination of
+ *        the feature allocation and the workspace mode.
+ *
+ *        The allocations are counted by replacing the global operator
+ *        new. The first calls warm up the workspace and are excluded.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "manifold.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static std::atomic<long> numAllocations(0);
+
+void* operator new(size_t size)
+{
+    numAllocations++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+
+static std::vector<std::vector<Vec3>> pointSets(
+    const long numSets,
+    const long numPoints,
+    const bool onSphere
+) {
+    std::mt19937_64                        engine(1);
+    std::normal_distribution<double>       dist;
+    std::vector<std::vector<Vec3>>         sets;
+
+    for (long i = 0; i < numSets; i++) {
+        std::vector<Vec3> points;
+        for (long j = 0; j < numPoints; j++) {
+            Vec3 v(dist(engine), dist(engine), dist(engine));
+            if (onSphere) {
+                v.normalize();
+            }
+            points.push_back(v);
+        }
+        sets.push_back(points);
+    }
+    return sets;
+}
+
+
+static void run(const char* name, std::vector<std::vector<Vec3>>& sets)
+{
+    const long warmup  = 16;
+    const long repeat  = 2000;
+
+    for (auto alloc : { Manifold::FEATURE_ALLOCATION_HEAP,
+                        Manifold::FEATURE_ALLOCATION_POOL }) {
+        for (auto ws : { Manifold::WORKSPACE_RELEASE,
+                         Manifold::WORKSPACE_RETAIN   }) {
+
+            Manifold       m;
+            enum predicate pred;
+            m.setFeatureAllocation(alloc);
+            m.setWorkspaceMode(ws);
+
+            for (long i = 0; i < warmup; i++) {
+                m.clear();
+                m.findConvexHull(sets[i % sets.size()], pred);
+            }
+
+            const long n0 = numAllocations;
+            const double t0 = benchNowMs();
+            for (long i = 0; i < repeat; i++) {
+                m.clear();
+                m.findConvexHull(sets[i % sets.size()], pred);
+            }
+            const double t1 = benchNowMs();
+            const long n1 = numAllocations;
+
+            printf("%-12s n=%5zu  %-4s %-7s  "
+                   "%9.1f allocs/call  %8.2f us/call\n",
+                   name, sets[0].size(),
+                   (alloc == Manifold::FEATURE_ALLOCATION_POOL) ? "pool":"heap",
+                   (ws == Manifold::WORKSPACE_RETAIN) ? "retain" : "release",
+                   (double)(n1 - n0) / repeat, (t1 - t0) * 1.0e3 / repeat);
+        }
+    }
+}
+
+
+int main()
+{
+    auto c32  = pointSets(64, 32,  false);
+    run("gaussian", c32);
+
+    auto c256 = pointSets(64, 256, false);
+    run("gaussian", c256);
+
+    auto s256 = pointSets(64, 256, true);
+    run("sphere", s256);
+
+    return 0;
+}
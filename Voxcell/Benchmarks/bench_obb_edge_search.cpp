@@ -0,0 +1,142 @@
+/**
+ * @file bench_obb_edge_search.cpp
+ *
+ * @brief compares the runtime and the volume of findOBB3D() with
+ *        OBB_MODE_FACE_NORMALS and OBB_MODE_EDGE_SEARCH.
+ *
+ *        The inputs are the convex hulls of:
+ *        - the vertices of the demo mesh (the cow). The duck model in the
+ *          demo is the same file.
+ *        - a regular tetrahedron, whose minimum box is a cube of half
+ *          the volume of the best box flush with a face,
+ *        - randomly rotated cylinders, on which the silhouettes miss the
+ *          vertices within the tolerance of the hull,
+ *        - small random point sets.
+ *
+ *        The hull is built once per input and excluded from the time.
+ *        It returns 1 if OBB_MODE_EDGE_SEARCH makes a larger box than
+ *        OBB_MODE_FACE_NORMALS for any input.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <random>
+
+#include "manifold.hpp"
+#include "orienting_bounding_box.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static bool run(const char* name, std::vector<Vec3>& points)
+{
+    const int repeat = 3;
+
+    Manifold       hull;
+    enum predicate pred;
+    hull.findConvexHull(points, pred);
+    auto fp = hull.faces();
+    long numFaces = std::distance(fp.first, fp.second);
+
+    CompactMesh mesh;
+    mesh.build(hull);
+
+    double volumeFace  = 0.0;
+    double volumeEdge = 0.0;
+
+    auto tFace = benchMinMs(repeat, [&]{
+        Manifold obb;
+        Mat3x3   axes;
+        Vec3     center;
+        Vec3     extents;
+        findOBB3D(mesh, obb, axes, center, extents, volumeFace,
+                  OBB_MODE_FACE_NORMALS);
+    });
+
+    auto tEdge = benchMinMs(repeat, [&]{
+        Manifold obb;
+        Mat3x3   axes;
+        Vec3     center;
+        Vec3     extents;
+        findOBB3D(mesh, obb, axes, center, extents, volumeEdge,
+                  OBB_MODE_EDGE_SEARCH);
+    });
+
+    printf("%-20s hull F=%5ld  face: %10.4f ms V=%12.6f  "
+           "edge: %10.4f ms V=%12.6f  volume ratio: %8.5f\n",
+           name, numFaces, tFace, volumeFace, tEdge, volumeEdge,
+           volumeEdge / volumeFace);
+
+    return volumeEdge <= volumeFace;
+}
+
+
+static std::vector<Vec3> cylinderPoints(
+    std::mt19937_64& engine,
+    const long       numSides
+) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    Vec3 axis(dist(engine), dist(engine), dist(engine));
+    axis.normalize();
+    Vec3 u = axis.cross(Vec3(1.0, 0.0, 0.0));
+    if (u.squaredNorm2() < 0.1) {
+        u = axis.cross(Vec3(0.0, 1.0, 0.0));
+    }
+    u.normalize();
+    Vec3 w = axis.cross(u);
+
+    std::vector<Vec3> points;
+    for (long i = 0; i < numSides; i++) {
+        const double a = 2.0 * M_PI * i / numSides;
+        Vec3 r = u * cos(a) + w * sin(a);
+        points.push_back(r + axis);
+        points.push_back(r - axis);
+    }
+    return points;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string modelDir = (argc > 1) ? argv[1] : BENCH_MODEL_DIR;
+    bool        ok       = true;
+
+    for (auto name : { "spot_smoothed.obj" }) {
+        auto points = benchLoadObjVertices(modelDir + name);
+        if (points.empty()) {
+            printf("%-20s not found in %s\n", name, modelDir.c_str());
+            continue;
+        }
+        ok = run(name, points) && ok;
+    }
+
+    std::vector<Vec3> tetrahedron = { Vec3( 1.0,  1.0,  1.0),
+                                      Vec3( 1.0, -1.0, -1.0),
+                                      Vec3(-1.0,  1.0, -1.0),
+                                      Vec3(-1.0, -1.0,  1.0)  };
+    ok = run("tetrahedron", tetrahedron) && ok;
+
+    std::mt19937_64 cylinderEngine(1);
+    for (long numSides : { 16, 32, 64, 128 }) {
+        auto points = cylinderPoints(cylinderEngine, numSides);
+        ok = run("cylinder", points) && ok;
+    }
+
+    std::mt19937_64                        engine(1);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (int i = 0; i < 3; i++) {
+        std::vector<Vec3> points;
+        for (int j = 0; j < 30; j++) {
+            points.emplace_back(
+                       dist(engine), 2.0 * dist(engine), 0.5 * dist(engine));
+        }
+        ok = run("random 30 points", points) && ok;
+    }
+
+    if (!ok) {
+        printf("FAILED: OBB_MODE_EDGE_SEARCH made a larger box\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file bench_obb_fast.cpp
+ *
+ * @brief compares the runtime and the volume of findOBB3DFast() on the raw
+ *        points with the hull and findOBB3D() with OBB_MODE_FACE_NORMALS
+ *        and OBB_MODE_EDGE_SEARCH.
+ *
+ *        The inputs are:
+ *        - the vertices of the demo mesh (the cow). The duck model in the
+ *          demo is the same file.
+ *        - points in randomly rotated boxes,
+ *        - small random point sets.
+ *
+ *        The time of the hull paths includes findConvexHull(), as
+ *        findOBB3DFast() works on the raw points.
+ *
+ *        See README.md for how to build and run.
+ */
+#include <random>
+
+#include "manifold.hpp"
+#include "orienting_bounding_box.hpp"
+#include "bench_common.hpp"
+
+using namespace Makena;
+
+
+static void run(const char* name, std::vector<Vec3>& points)
+{
+    const int repeat = 3;
+
+    double volumeFast  = 0.0;
+    double volumeFace  = 0.0;
+    double volumeEdge = 0.0;
+
+    auto tFast = benchMinMs(repeat * 10, [&]{
+        Manifold obb;
+        Mat3x3   axes;
+        Vec3     center;
+        Vec3     extents;
+        findOBB3DFast(points, obb, axes, center, extents, volumeFast);
+    });
+
+    auto hullPath = [&](enum OBBMode mode, double& volume) {
+        std::vector<Vec3> copied = points;
+        Manifold          hull;
+        enum predicate    pred;
+        hull.findConvexHull(copied, pred);
+
+        Manifold obb;
+        Mat3x3   axes;
+        Vec3     center;
+        Vec3     extents;
+        findOBB3D(hull, obb, axes, center, extents, volume, mode);
+    };
+
+    auto tFace = benchMinMs(repeat, [&]{
+        hullPath(OBB_MODE_FACE_NORMALS, volumeFace);
+    });
+
+    auto tEdge = benchMinMs(repeat, [&]{
+        hullPath(OBB_MODE_EDGE_SEARCH, volumeEdge);
+    });
+
+    printf("%-18s N=%6zu  fast: %9.4f ms V/Vedge=%7.4f  "
+           "face: %9.4f ms V/Vedge=%7.4f  edge: %9.4f ms V=%10.5f\n",
+           name, points.size(), tFast, volumeFast / volumeEdge,
+           tFace, volumeFace / volumeEdge, tEdge, volumeEdge);
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string modelDir = (argc > 1) ? argv[1] : BENCH_MODEL_DIR;
+
+    for (auto name : { "spot_smoothed.obj" }) {
+        auto points = benchLoadObjVertices(modelDir + name);
+        if (points.empty()) {
+            printf("%-18s not found in %s\n", name, modelDir.c_str());
+            continue;
+        }
+        run(name, points);
+    }
+
+    std::mt19937_64                        engine(1);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    for (int i = 0; i < 3; i++) {
+        Vec3       axis(dist(engine), dist(engine), dist(engine));
+        Quaternion q(axis, 3.0 * dist(engine));
+        q.normalize();
+        std::vector<Vec3> points;
+        for (int j = 0; j < 10000; j++) {
+            Vec3 p(3.0 * dist(engine), dist(engine), 0.3 * dist(engine));
+            points.push_back(q.rotate(p));
+        }
+        run("rotated box", points);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        std::vector<Vec3> points;
+        for (int j = 0; j < 30; j++) {
+            points.emplace_back(
+                       dist(engine), 2.0 * dist(engine), 0.5 * dist(engine));
+        }
+        run("random 30 points", points);
+    }
+
+    return 0;
+}
@@ -30,4 +30,26 @@ extension Brep {
 
         return constructFeaturesFromManifoldObjc( mObjc );
     }
+
+    /// Constructs a convex hull from the given cells in the grid such as the ones from `VolumeBitmap.findShell()`
+    ///
+    /// - Only the cells at the ends of their rows, columns, and slabs can be the vertices of the hull. The others are discarded before the construction.
+    /// - The hull is found on the integer grid coordinates with exact integer predicates, and then it is mapped to the 3D space by the grid pitch.
+    ///
+    /// - parameter gridCells: array of the integer coordinates of the cells
+    /// - parameter gridInfo: the grid the cells belong to
+    /// - returns: A Brep that represents the convex hull of the center points of the cells.
+    ///
+    static public func findConvexHull( gridCells : [ SIMD3<Int32> ], gridInfo : GridInfo ) -> Brep {
+
+        let p : UnsafePointer< SIMD3<Int32> >? = gridCells.withUnsafeBufferPointer( { ptr in return ptr.baseAddress ?? nil})
+
+        let mObjc : ManifoldObjc = ManifoldObjc()
+
+        let origin = gridInfo.centerPointFromGridCoords( x: 0, y: 0, z: 0 )
+
+        mObjc.findGridConvexHull( p, numCells: Int32(gridCells.count), origin: origin, pitch: gridInfo.pitch )
+
+        return constructFeaturesFromManifoldObjc( mObjc );
+    }
 }
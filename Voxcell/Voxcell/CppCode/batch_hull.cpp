@@ -0,0 +1,183 @@
+#include "batch_hull.hpp"
+#include "orienting_bounding_box.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file batch_hull.cpp
+ *
+ * @brief Finds the convex hulls and optionally the oriented bounding boxes
+ *        of many point sets with a fixed number of worker threads.
+ *
+ */
+namespace Makena {
+
+using namespace std;
+
+
+BatchHullFinder::BatchHullFinder(const long numThreads):
+    mJobSerial(0),
+    mNumBusyThreads(0),
+    mStopping(false),
+    mSpans(nullptr),
+    mFindOBB(false),
+    mResults(nullptr),
+    mNext(0)
+{
+    long n = numThreads;
+    if (n <= 0) {
+        n = std::max(1L, (long)std::thread::hardware_concurrency());
+    }
+    for (long i = 0; i < n; i++) {
+        mWorkspaces.push_back(make_unique<Workspace>());
+    }
+    mErrors.resize(n);
+    for (long k = 1; k < n; k++) {
+        mThreads.emplace_back(&BatchHullFinder::runWorker, this, k);
+    }
+}
+
+
+BatchHullFinder::~BatchHullFinder()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mJobPosted.notify_all();
+    for (auto& t : mThreads) {
+        t.join();
+    }
+}
+
+
+void BatchHullFinder::runWorker(const long k)
+{
+    long serial = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobPosted.wait(lock, [&]{
+                return mStopping || mJobSerial != serial;
+            });
+            if (mStopping) {
+                return;
+            }
+            serial = mJobSerial;
+        }
+
+        runJob(k);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mNumBusyThreads--;
+            if (mNumBusyThreads == 0) {
+                mJobDone.notify_all();
+            }
+        }
+    }
+}
+
+
+void BatchHullFinder::runJob(const long k)
+{
+    const long numSpans = mSpans->size();
+    try {
+        for (long i = mNext++; i < numSpans; i = mNext++) {
+            findOne(*(mWorkspaces[k]), (*mSpans)[i], mFindOBB, (*mResults)[i]);
+        }
+    }
+    catch (...) {
+        mErrors[k] = std::current_exception();
+        mNext = numSpans;
+    }
+}
+
+
+void BatchHullFinder::find(
+    const vector<PointSpan>&  spans,
+    const bool                findOBB,
+    vector<BatchHullResult>&  results
+) {
+    results.clear();
+    results.resize(spans.size());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSpans          = &spans;
+        mFindOBB        = findOBB;
+        mResults        = &results;
+        mNext           = 0;
+        mErrors.assign(mWorkspaces.size(), nullptr);
+        mNumBusyThreads = mThreads.size();
+        mJobSerial++;
+    }
+    mJobPosted.notify_all();
+
+    runJob(0);
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobDone.wait(lock, [&]{ return mNumBusyThreads == 0; });
+        mSpans   = nullptr;
+        mResults = nullptr;
+    }
+
+    for (auto& e : mErrors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+
+void BatchHullFinder::findOne(
+    Workspace&        ws,
+    const PointSpan&  span,
+    const bool        findOBB,
+    BatchHullResult&  result
+) {
+    ws.mHull.clear();
+    ws.mPoints.assign(span.mPoints, span.mPoints + span.mNumPoints);
+
+    ws.mHull.findConvexHull(ws.mPoints, result.mPred);
+    if (result.mPred != NONE) {
+        return;
+    }
+
+    // Vertices. Their IDs are the indices into the span.
+    ws.mIdToIndex.assign(span.mNumPoints, -1);
+    auto vPair = ws.mHull.vertices();
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        ws.mIdToIndex[(*vit)->id()] = result.mVertices.size();
+        result.mVertices.push_back((*vit)->pLCS());
+        result.mVertexIndices.push_back((*vit)->id());
+    }
+
+    // Faces
+    auto fPair = ws.mHull.faces();
+    for (auto fit = fPair.first; fit != fPair.second; fit++) {
+        vector<long> face;
+        for (auto heit : (*fit)->halfEdges()) {
+            face.push_back(ws.mIdToIndex[(*((*heit)->src()))->id()]);
+        }
+        result.mFaces.push_back(std::move(face));
+    }
+
+    if (findOBB) {
+        ws.mOBB.clear();
+        findOBB3D( ws.mHull,
+                   ws.mOBB,
+                   result.mOBBAxes,
+                   result.mOBBCenter,
+                   result.mOBBExtent,
+                   result.mOBBVolume  );
+        result.mHasOBB = true;
+    }
+}
+
+
+}// namespace Makena
@@ -0,0 +1,243 @@
+#ifndef _MAKENA_BATCH_HULL_HPP_
+#define _MAKENA_BATCH_HULL_HPP_
+
+#include <memory>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <list>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+#include <cmath>
+
+#include "primitives.hpp"
+#include "manifold.hpp"
+
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file batch_hull.hpp
+ *
+ * @brief Finds the convex hulls and optionally the oriented bounding boxes
+ *        of many point sets with a fixed number of worker threads.
+ *
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @class PointSpan
+ *
+ *  @brief non-owning view of a contiguous array of points.
+ */
+class PointSpan {
+
+  public:
+
+    inline PointSpan(const Vec3* points, const long numPoints);
+
+    /** @brief the first point. */
+    const Vec3* mPoints;
+
+    /** @brief the number of points. */
+    long        mNumPoints;
+};
+
+
+/** @class BatchHullResult
+ *
+ *  @brief the convex hull and the OBB found for a PointSpan.
+ */
+class BatchHullResult {
+
+  public:
+
+    inline BatchHullResult();
+
+    /** @brief predicate returned from findConvexHull(). If it is not NONE,
+     *         the rest of the members are empty.
+     */
+    enum predicate        mPred;
+
+    /** @brief the vertices of the hull. */
+    vector<Vec3>          mVertices;
+
+    /** @brief the indices into the input span of mVertices. */
+    vector<long>          mVertexIndices;
+
+    /** @brief the faces as the indices into mVertices in counter-clockwise
+     *         ordering.
+     */
+    vector<vector<long>>  mFaces;
+
+    /** @brief true if the OBB has been found. */
+    bool                  mHasOBB;
+
+    /** @brief the axes of the OBB. */
+    Mat3x3                mOBBAxes;
+
+    /** @brief the center of the OBB. */
+    Vec3                  mOBBCenter;
+
+    /** @brief the lengths of the OBB along the axes. */
+    Vec3                  mOBBExtent;
+
+    /** @brief the volume of the OBB. */
+    double                mOBBVolume;
+};
+
+
+/** @class BatchHullFinder
+ *
+ *  @brief runs Manifold::findConvexHull() and optionally findOBB3D() on
+ *         many point sets with a fixed number of worker threads.
+ *         The worker threads are started by the constructor and wait for
+ *         the jobs between the calls to find(). The thread calling find()
+ *         works as the first worker.
+ *         Each worker owns a workspace with Manifolds in WORKSPACE_RETAIN
+ *         mode that are cleared and reused for all the point sets it
+ *         processes, and the workspaces are kept across the calls to
+ *         find().
+ *         The workers take the next point set from a shared counter,
+ *         and write the result to the slot of the same index.
+ *         find() must not be called from more than one thread at a time.
+ */
+class BatchHullFinder {
+
+  public:
+
+    /** @brief constructor. It starts the worker threads.
+     *
+     *  @param numThreads (in): the number of worker threads including the
+     *                          one calling find(). 0 means
+     *                          std::thread::hardware_concurrency().
+     */
+    BatchHullFinder(const long numThreads = 0);
+
+    /** @brief destructor. It stops and joins the worker threads. */
+    ~BatchHullFinder();
+
+    /** @brief finds the convex hulls of the given point sets.
+     *
+     *  @param spans   (in):  the point sets.
+     *
+     *  @param findOBB (in):  true if the OBBs are found as well.
+     *
+     *  @param results (out): the results in the same order as spans.
+     *
+     *  @throws the first exception thrown in any of the workers after
+     *          all the workers have stopped.
+     */
+    void find(
+        const vector<PointSpan>&  spans,
+        const bool                findOBB,
+        vector<BatchHullResult>&  results
+    );
+
+    /** @brief returns the number of the worker threads. */
+    inline long numThreads() const;
+
+  private:
+
+    class Workspace {
+
+      public:
+        Workspace():mHull(mNullStream),mOBB(mNullStream)
+        {
+            mHull.setWorkspaceMode(Manifold::WORKSPACE_RETAIN);
+            mOBB.setWorkspaceMode(Manifold::WORKSPACE_RETAIN);
+        }
+
+        /** @brief log sink for the Manifolds. Logging is off. */
+        std::ostringstream mNullStream;
+
+        /** @brief hull reused for all the point sets. */
+        Manifold           mHull;
+
+        /** @brief OBB reused for all the point sets. */
+        Manifold           mOBB;
+
+        /** @brief copy of the input points reused for all the point sets. */
+        vector<Vec3>       mPoints;
+
+        /** @brief map from the vertex id to the index in mVertices. */
+        vector<long>       mIdToIndex;
+    };
+
+    void findOne(
+        Workspace&        ws,
+        const PointSpan&  span,
+        const bool        findOBB,
+        BatchHullResult&  result
+    );
+
+    /** @brief the loop of the worker thread k, k >= 1. */
+    void runWorker(const long k);
+
+    /** @brief processes the point sets of the current job until the
+     *         shared counter reaches the end.
+     */
+    void runJob(const long k);
+
+    vector<unique_ptr<Workspace>>  mWorkspaces;
+
+    /** @brief the worker threads 1 to n-1. */
+    vector<std::thread>            mThreads;
+
+    std::mutex                     mMutex;
+
+    /** @brief notified when a job is posted or the workers are stopped. */
+    std::condition_variable        mJobPosted;
+
+    /** @brief notified when the last worker thread finishes the job. */
+    std::condition_variable        mJobDone;
+
+    /** @brief incremented for each job. */
+    long                           mJobSerial;
+
+    /** @brief number of the worker threads still in the current job. */
+    long                           mNumBusyThreads;
+
+    bool                           mStopping;
+
+    /** @brief the current job. */
+    const vector<PointSpan>*       mSpans;
+    bool                           mFindOBB;
+    vector<BatchHullResult>*       mResults;
+    std::atomic<long>              mNext;
+    vector<exception_ptr>          mErrors;
+};
+
+
+inline PointSpan::PointSpan(const Vec3* points, const long numPoints):
+    mPoints(points),
+    mNumPoints(numPoints){;}
+
+
+inline BatchHullResult::BatchHullResult():
+    mPred(NONE),
+    mHasOBB(false),
+    mOBBVolume(0.0){;}
+
+
+inline long BatchHullFinder::numThreads() const
+{
+    return mWorkspaces.size();
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_BATCH_HULL_HPP_*/
@@ -0,0 +1,115 @@
+#include <unordered_map>
+
+#include "compact_mesh.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file compact_mesh.cpp
+ *
+ * @brief Frozen index-based half-edge mesh built from a Manifold.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+void CompactMesh::build(Manifold& m)
+{
+    clear();
+
+    auto vPair = m.vertices();
+    auto fPair = m.faces();
+
+    unordered_map<const Vertex*, uint32_t> vIndices;
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        vIndices[vit->get()] = (uint32_t)mPositions.size();
+        mPositions.push_back((*vit)->pLCS());
+        mVertexIds.push_back((*vit)->id());
+    }
+
+    // The half edges of a face are laid out contiguously in the order
+    // of Face::halfEdges(), which gives next and prev directly.
+    unordered_map<const HalfEdge*, uint32_t> heIndices;
+    vector<const HalfEdge*>                  heBuddies;
+    for (auto fit = fPair.first; fit != fPair.second; fit++) {
+
+        const uint32_t f     = (uint32_t)mFaceNormals.size();
+        const uint32_t first = (uint32_t)mHeNext.size();
+        const auto&    hes   = (*fit)->halfEdges();
+        const uint32_t n     = (uint32_t)hes.size();
+
+        mFaceNormals.push_back((*fit)->nLCS());
+        mFaceIds.push_back((*fit)->id());
+
+        uint32_t k = 0;
+        for (auto heit : hes) {
+            heIndices[heit->get()] = first + k;
+            heBuddies.push_back((*heit)->buddy()->get());
+            mHeNext.push_back(first + (k + 1) % n);
+            mHePrev.push_back(first + (k + n - 1) % n);
+            mHeSrc.push_back(vIndices[(*heit)->src()->get()]);
+            mHeFace.push_back(f);
+            k++;
+        }
+        mFaceHalfEdges.push_back((uint32_t)mHeNext.size());
+    }
+
+    mHeTwin.assign(mHeNext.size(), INVALID_INDEX);
+    for (size_t i = 0; i < heBuddies.size(); i++) {
+        auto it = heIndices.find(heBuddies[i]);
+        if (it != heIndices.end()) {
+            mHeTwin[i] = it->second;
+        }
+    }
+
+    mVertexHalfEdge.assign(mPositions.size(), INVALID_INDEX);
+    uint32_t v = 0;
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        for (auto heit : (*vit)->halfEdges()) {
+            if ((*heit)->src() != vit) {
+                continue;
+            }
+            auto it = heIndices.find(heit->get());
+            if (it != heIndices.end()) {
+                mVertexHalfEdge[v] = it->second;
+                break;
+            }
+        }
+        v++;
+    }
+}
+
+
+void CompactMesh::verticesAroundFace(
+    const uint32_t    f,
+    vector<uint32_t>& vertices
+) const {
+    vertices.clear();
+    for (auto he = faceHalfEdgesBegin(f); he != faceHalfEdgesEnd(f); he++) {
+        vertices.push_back(dst(he));
+    }
+}
+
+
+void CompactMesh::facesAroundVertex(
+    const uint32_t    v,
+    vector<uint32_t>& faces
+) const {
+    faces.clear();
+    const auto first = mVertexHalfEdge[v];
+    if (first == INVALID_INDEX) {
+        return;
+    }
+    auto he = first;
+    do {
+        faces.push_back(mHeFace[he]);
+        he = nextAroundVertexCCW(he);
+    } while (he != first && he != INVALID_INDEX);
+}
+
+
+}// namespace Makena
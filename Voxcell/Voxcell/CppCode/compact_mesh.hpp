@@ -0,0 +1,292 @@
+#ifndef _MAKENA_COMPACT_MESH_HPP_
+#define _MAKENA_COMPACT_MESH_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "primitives.hpp"
+#include "manifold.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file compact_mesh.hpp
+ *
+ * @brief Frozen index-based half-edge mesh built from a Manifold.
+ *        The connectivity is kept in the structure of arrays of 32-bit
+ *        indices, and the positions and the normals in contiguous arrays.
+ *        It is meant for the traversal-heavy read-only queries on a
+ *        finished Manifold such as a convex hull.
+ *
+ *        The half edges of a face are stored contiguously in the
+ *        counter-clockwise order seen from outside, i.e., in the order of
+ *        Face::halfEdges(). The vertices and the faces are indexed in the
+ *        order of Manifold::vertices() and Manifold::faces().
+ */
+namespace Makena {
+
+using namespace std;
+
+
+class CompactMesh {
+
+  public:
+
+    /** @brief index for no element such as the twin of a border half edge.
+     */
+    static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+    inline CompactMesh();
+    inline ~CompactMesh();
+
+    /** @brief builds this mesh from the given manifold in O(n).
+     *         The previous contents are discarded.
+     *         The half edges that do not belong to any face are ignored.
+     *
+     *  @param m (in): the manifold. It is not modified.
+     */
+    void build(Manifold& m);
+
+    /** @brief resets this mesh to the empty state. */
+    inline void clear();
+
+    inline uint32_t numVertices()  const;
+    inline uint32_t numHalfEdges() const;
+    inline uint32_t numFaces()     const;
+
+    /** @brief coordinates of the vertices in LCS. */
+    inline const vector<Vec3>& positions() const;
+
+    /** @brief normals of the faces in LCS. */
+    inline const vector<Vec3>& faceNormals() const;
+
+    inline const Vec3& position(const uint32_t v) const;
+    inline const Vec3& faceNormal(const uint32_t f) const;
+
+    /** @brief IDs of the vertex and the face in the original manifold. */
+    inline long vertexId(const uint32_t v) const;
+    inline long faceId(const uint32_t f) const;
+
+    /** @brief half edge connectivity */
+    inline uint32_t next(const uint32_t he) const;
+    inline uint32_t prev(const uint32_t he) const;
+    inline uint32_t twin(const uint32_t he) const;
+    inline uint32_t src (const uint32_t he) const;
+    inline uint32_t dst (const uint32_t he) const;
+    inline uint32_t face(const uint32_t he) const;
+
+    /** @brief the half edges of the face f are
+     *         [faceHalfEdgesBegin(f), faceHalfEdgesEnd(f)).
+     */
+    inline uint32_t faceHalfEdgesBegin(const uint32_t f) const;
+    inline uint32_t faceHalfEdgesEnd  (const uint32_t f) const;
+
+    /** @brief number of the half edges, i.e., the vertices, of the face. */
+    inline uint32_t faceDegree(const uint32_t f) const;
+
+    /** @brief an outgoing half edge of the vertex, or INVALID_INDEX if
+     *         it is isolated.
+     */
+    inline uint32_t vertexHalfEdge(const uint32_t v) const;
+
+    /** @brief the next outgoing half edge around src(he) in the
+     *         counter-clockwise order seen from outside, or INVALID_INDEX
+     *         if it crosses a border.
+     */
+    inline uint32_t nextAroundVertexCCW(const uint32_t he) const;
+
+    /** @brief finds the vertices of the face in the counter-clockwise order
+     *         seen from outside. It starts at dst of the first half edge as
+     *         in the order of Face::halfEdges().
+     *
+     *  @param f        (in):  the face
+     *
+     *  @param vertices (out): the vertices. The contents are replaced.
+     */
+    void verticesAroundFace(const uint32_t f, vector<uint32_t>& vertices)
+                                                                      const;
+
+    /** @brief finds the incident faces of the vertex in the counter-
+     *         clockwise order seen from outside. If the vertex is on a
+     *         border, it stops at the border.
+     *
+     *  @param v     (in):  the vertex
+     *
+     *  @param faces (out): the faces. The contents are replaced.
+     */
+    void facesAroundVertex(const uint32_t v, vector<uint32_t>& faces) const;
+
+  private:
+
+    vector<Vec3>     mPositions;
+    vector<Vec3>     mFaceNormals;
+    vector<long>     mVertexIds;
+    vector<long>     mFaceIds;
+
+    vector<uint32_t> mHeNext;
+    vector<uint32_t> mHePrev;
+    vector<uint32_t> mHeTwin;
+    vector<uint32_t> mHeSrc;
+    vector<uint32_t> mHeFace;
+
+    /** @brief offsets into the half edges. Its size is numFaces() + 1. */
+    vector<uint32_t> mFaceHalfEdges;
+
+    vector<uint32_t> mVertexHalfEdge;
+
+#ifdef UNIT_TESTS
+  friend class CompactMeshTests;
+#endif
+
+};
+
+
+inline CompactMesh::CompactMesh():mFaceHalfEdges(1, 0){;}
+
+
+inline CompactMesh::~CompactMesh(){;}
+
+
+inline void CompactMesh::clear()
+{
+    mPositions.clear();
+    mFaceNormals.clear();
+    mVertexIds.clear();
+    mFaceIds.clear();
+    mHeNext.clear();
+    mHePrev.clear();
+    mHeTwin.clear();
+    mHeSrc.clear();
+    mHeFace.clear();
+    mFaceHalfEdges.assign(1, 0);
+    mVertexHalfEdge.clear();
+}
+
+
+inline uint32_t CompactMesh::numVertices() const
+{
+    return (uint32_t)mPositions.size();
+}
+
+
+inline uint32_t CompactMesh::numHalfEdges() const
+{
+    return (uint32_t)mHeNext.size();
+}
+
+
+inline uint32_t CompactMesh::numFaces() const
+{
+    return (uint32_t)mFaceNormals.size();
+}
+
+
+inline const vector<Vec3>& CompactMesh::positions() const
+{
+    return mPositions;
+}
+
+
+inline const vector<Vec3>& CompactMesh::faceNormals() const
+{
+    return mFaceNormals;
+}
+
+
+inline const Vec3& CompactMesh::position(const uint32_t v) const
+{
+    return mPositions[v];
+}
+
+
+inline const Vec3& CompactMesh::faceNormal(const uint32_t f) const
+{
+    return mFaceNormals[f];
+}
+
+
+inline long CompactMesh::vertexId(const uint32_t v) const
+{
+    return mVertexIds[v];
+}
+
+
+inline long CompactMesh::faceId(const uint32_t f) const
+{
+    return mFaceIds[f];
+}
+
+
+inline uint32_t CompactMesh::next(const uint32_t he) const
+{
+    return mHeNext[he];
+}
+
+
+inline uint32_t CompactMesh::prev(const uint32_t he) const
+{
+    return mHePrev[he];
+}
+
+
+inline uint32_t CompactMesh::twin(const uint32_t he) const
+{
+    return mHeTwin[he];
+}
+
+
+inline uint32_t CompactMesh::src(const uint32_t he) const
+{
+    return mHeSrc[he];
+}
+
+
+inline uint32_t CompactMesh::dst(const uint32_t he) const
+{
+    return mHeSrc[mHeNext[he]];
+}
+
+
+inline uint32_t CompactMesh::face(const uint32_t he) const
+{
+    return mHeFace[he];
+}
+
+
+inline uint32_t CompactMesh::faceHalfEdgesBegin(const uint32_t f) const
+{
+    return mFaceHalfEdges[f];
+}
+
+
+inline uint32_t CompactMesh::faceHalfEdgesEnd(const uint32_t f) const
+{
+    return mFaceHalfEdges[f + 1];
+}
+
+
+inline uint32_t CompactMesh::faceDegree(const uint32_t f) const
+{
+    return mFaceHalfEdges[f + 1] - mFaceHalfEdges[f];
+}
+
+
+inline uint32_t CompactMesh::vertexHalfEdge(const uint32_t v) const
+{
+    return mVertexHalfEdge[v];
+}
+
+
+inline uint32_t CompactMesh::nextAroundVertexCCW(const uint32_t he) const
+{
+    return mHeTwin[mHePrev[he]];
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_COMPACT_MESH_HPP_*/
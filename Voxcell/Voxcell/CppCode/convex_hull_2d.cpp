@@ -29,7 +29,8 @@ class CHinternal {
 
 class CH2sort {
   public:
-    bool operator() (CHinternal& i,CHinternal& j)
+    template<class P>
+    bool operator() (const P& i, const P& j)
     { 
         if ( (i.mP.x() < j.mP.x()) ||
              ((i.mP.x() == j.mP.x())&&(i.mP.y() < j.mP.y())) ) {
@@ -41,7 +42,8 @@ class CH2sort {
     }
 };
 
-static void updateStack(std::vector<CHinternal>& us, CHinternal& p, bool Upper)
+template<class P>
+static void updateStack(std::vector<P>& us, const P& p, bool Upper)
 {
     if (us.size() <= 1) {
         us.push_back(p);
@@ -146,6 +148,51 @@ std::vector<long> findConvexHull2D(std::vector<Vec3>& points)
 }
 
 
+void ConvexHull2DWorkspace::reserve(const long numPoints)
+{
+    mPoints.reserve(numPoints);
+    mUpperStack.reserve(numPoints);
+    mLowerStack.reserve(numPoints);
+}
+
+
+void findConvexHull2D(
+    const double*          ys,
+    const double*          zs,
+    const long             numPoints,
+    ConvexHull2DWorkspace& ws,
+    vector<long>&          hull
+) {
+    ws.mPoints.resize(numPoints);
+    for (long i = 0; i < numPoints; i++) {
+        ws.mPoints[i].mP     = Vec2(ys[i], zs[i]);
+        ws.mPoints[i].mIndex = i;
+    }
+
+    CH2sort compObj;
+    std::sort(ws.mPoints.begin(), ws.mPoints.end(), compObj);
+
+    ws.mUpperStack.clear();
+    ws.mLowerStack.clear();
+
+    for (auto& p : ws.mPoints) {
+
+        updateStack(ws.mUpperStack, p, true);
+
+        updateStack(ws.mLowerStack, p, false);
+
+    }
+
+    hull.clear();
+    for (auto& p : ws.mLowerStack) {
+        hull.push_back(p.mIndex);
+    }
+    for (long i = ws.mUpperStack.size()-2; i >= 1; i--) {
+        hull.push_back(ws.mUpperStack[i].mIndex);
+    }
+}
+
+
 #ifdef UNIT_TESTS
 void makeOpenGLVerticesColorsForLines(
     vector<Vec3>& points,
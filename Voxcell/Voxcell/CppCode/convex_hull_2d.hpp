@@ -49,6 +49,66 @@ vector<long> findConvexHull2D(vector<Vec3>& points);
 vector<long> findConvexHull2D(vector<Vec2>& points);
 
 
+/** @class ConvexHull2DWorkspace
+ *
+ *  @brief work memory of findConvexHull2D() kept by the caller. Once it
+ *         has grown to the number of the points, the calls make no heap
+ *         allocation.
+ */
+class ConvexHull2DWorkspace {
+
+  public:
+
+    /** @brief reserves the memory for the given number of the points. */
+    void reserve(const long numPoints);
+
+  private:
+
+    class Point {
+      public:
+        Vec2 mP;
+        long mIndex;
+    };
+
+    vector<Point> mPoints;
+    vector<Point> mUpperStack;
+    vector<Point> mLowerStack;
+
+  friend void findConvexHull2D(
+    const double*          ys,
+    const double*          zs,
+    const long             numPoints,
+    ConvexHull2DWorkspace& ws,
+    vector<long>&          hull
+  );
+};
+
+
+/** @brief findConvexHull2D() for the points on yz-plane given as the
+ *         separate arrays of the coordinates. It returns the same hull as
+ *         findConvexHull2D(vector<Vec3>&) without the heap allocation once
+ *         the workspace and the output have grown.
+ *
+ *  @param ys        (in):     the y coordinates of the points
+ *
+ *  @param zs        (in):     the z coordinates of the points
+ *
+ *  @param numPoints (in):     the number of the points
+ *
+ *  @param ws        (in/out): the work memory
+ *
+ *  @param hull      (out):    indices into the points along the convex
+ *                             hull in counter-clockwise ordering.
+ */
+void findConvexHull2D(
+    const double*          ys,
+    const double*          zs,
+    const long             numPoints,
+    ConvexHull2DWorkspace& ws,
+    vector<long>&          hull
+);
+
+
 #ifdef UNIT_TESTS
 
 
@@ -0,0 +1,484 @@
+#include <unordered_map>
+
+#include "dk_hierarchy.hpp"
+#include "feature_index.hpp"
+#include "geometric_predicates.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file dk_hierarchy.cpp
+ *
+ * @brief Dobkin-Kirkpatrick hierarchy of a convex Manifold.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+bool DKHierarchy::build(Manifold& m)
+{
+    clear();
+    mManifold = &m;
+
+    auto vPair = m.vertices();
+    auto fPair = m.faces();
+
+    unordered_map<const Vertex*, uint32_t> vIndices;
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        vIndices[vit->get()] = (uint32_t)mPositions.size();
+        mPositions.push_back((*vit)->pLCS());
+        mVertexIts.push_back(vit);
+    }
+
+    // Level 0. The faces are convex and triangulated as fans.
+    mLevelTriangles.push_back(0);
+    vector<uint32_t> faceVertices;
+    for (auto fit = fPair.first; fit != fPair.second; fit++) {
+        faceVertices.clear();
+        for (auto heit : (*fit)->halfEdges()) {
+            faceVertices.push_back(vIndices[(*heit)->src()->get()]);
+        }
+        for (size_t j = 1; j + 1 < faceVertices.size(); j++) {
+            pushTriangle(faceVertices[0],   faceVertices[j],
+                         faceVertices[j+1], INVALID_INDEX, INVALID_INDEX);
+        }
+    }
+    if (mTriDown.empty() || !linkTwins(0)) {
+        clear();
+        mManifold = &m;
+        return false;
+    }
+    mLevelTriangles.push_back(numTriangles());
+
+    const uint32_t       numAll = numVertices();
+    vector<uint32_t>     vertices(numAll);
+    vector<uint32_t>     kept;
+    vector<uint32_t>     removed;
+    vector<uint32_t>     link;
+    vector<uint32_t>     hole;
+    vector<VertexMark>   marks(numAll, VERTEX_FREE);
+
+    for (uint32_t v = 0; v < numAll; v++) {
+        vertices[v] = v;
+    }
+    mVertexTri.assign(numAll, INVALID_INDEX);
+
+    while (true) {
+
+        const uint32_t begin = mLevelTriangles[numLevels() - 1];
+        const uint32_t end   = mLevelTriangles[numLevels()];
+
+        // The vertices removed below keep the triangles of their last level.
+        for (uint32_t t = begin; t < end; t++) {
+            for (uint32_t k = 0; k < 3; k++) {
+                mVertexTri[mTriVertices[t * 3 + k]] = t;
+            }
+        }
+
+        if (vertices.size() <= MAX_TOP_VERTICES) {
+            break;
+        }
+
+        // Greedy independent set of the vertices of low degree.
+        for (auto v : vertices) {
+            marks[v] = VERTEX_FREE;
+        }
+        removed.clear();
+        hole.clear();
+        for (auto v : vertices) {
+            if (removed.size() * 2 >= vertices.size()) {
+                break;
+            }
+            if (marks[v] != VERTEX_FREE || !findLink(v, link)) {
+                continue;
+            }
+            if (!triangulateHole(v, link, hole)) {
+                continue;
+            }
+            marks[v] = VERTEX_REMOVED;
+            for (auto u : link) {
+                marks[u] = VERTEX_BLOCKED;
+            }
+            removed.push_back(v);
+        }
+
+        // A degenerate hull may leave few vertices removable. Stopping
+        // there keeps the total size linear.
+        if (removed.size() * 32 < vertices.size()) {
+            break;
+        }
+
+        const uint32_t nextBegin = numTriangles();
+        for (uint32_t t = begin; t < end; t++) {
+            const uint32_t* tv = &mTriVertices[t * 3];
+            if (marks[tv[0]] != VERTEX_REMOVED &&
+                marks[tv[1]] != VERTEX_REMOVED &&
+                marks[tv[2]] != VERTEX_REMOVED    ) {
+                pushTriangle(tv[0], tv[1], tv[2], t, INVALID_INDEX);
+            }
+        }
+        for (size_t i = 0; i < hole.size(); i += 4) {
+            pushTriangle(hole[i], hole[i+1], hole[i+2],
+                         INVALID_INDEX, hole[i+3]);
+        }
+        if (!linkTwins(nextBegin)) {
+            clear();
+            mManifold = &m;
+            return false;
+        }
+        mLevelTriangles.push_back(numTriangles());
+
+        kept.clear();
+        for (auto v : vertices) {
+            if (marks[v] != VERTEX_REMOVED) {
+                kept.push_back(v);
+            }
+        }
+        vertices.swap(kept);
+    }
+
+    mTopVertices = vertices;
+    return true;
+}
+
+
+bool DKHierarchy::linkTwins(const uint32_t begin)
+{
+    const uint32_t end = numTriangles();
+
+    VertexPairMap<uint32_t> halfEdges;
+    halfEdges.reset((end - begin) * 3);
+    for (uint32_t he = begin * 3; he < end * 3; he++) {
+        halfEdges.insert(
+                    make_pair((long)mTriVertices[he], (long)dst(he)), he);
+    }
+
+    mTriTwins.resize(end * 3);
+    for (uint32_t he = begin * 3; he < end * 3; he++) {
+        auto twin = halfEdges.find(make_pair((long)dst(he),
+                                             (long)mTriVertices[he]));
+        if (twin == nullptr) {
+            return false;
+        }
+        mTriTwins[he] = *twin;
+    }
+    return true;
+}
+
+
+bool DKHierarchy::findLink(const uint32_t v, vector<uint32_t>& link) const
+{
+    link.clear();
+
+    const uint32_t start = mVertexTri[v];
+    uint32_t       t     = start;
+    do {
+        uint32_t k = 0;
+        while (mTriVertices[t * 3 + k] != v) {
+            k++;
+        }
+        if (link.size() == MAX_REMOVAL_DEGREE) {
+            return false;
+        }
+        link.push_back(mTriVertices[t * 3 + (k + 1) % 3]);
+
+        // The half edge coming into v leads to the next triangle
+        // counter-clockwise around v.
+        t = mTriTwins[t * 3 + (k + 2) % 3] / 3;
+
+    } while (t != start);
+
+    return true;
+}
+
+
+bool DKHierarchy::triangulateHole(
+    const uint32_t          v,
+    const vector<uint32_t>& link,
+    vector<uint32_t>&       hole
+) const {
+
+    const size_t holeSize = hole.size();
+    const Vec3&  pv       = mPositions[v];
+
+    uint32_t ring[MAX_REMOVAL_DEGREE];
+    size_t   ringSize = link.size();
+    for (size_t i = 0; i < ringSize; i++) {
+        ring[i] = link[i];
+    }
+
+    while (ringSize >= 3) {
+
+        bool clipped = false;
+        for (size_t i = 0; i < ringSize && !clipped; i++) {
+
+            const uint32_t a  = ring[(i + ringSize - 1) % ringSize];
+            const uint32_t b  = ring[i];
+            const uint32_t c  = ring[(i + 1) % ringSize];
+            const Vec3&    pa = mPositions[a];
+            const Vec3&    pb = mPositions[b];
+            const Vec3&    pc = mPositions[c];
+
+            // v may be on the plane of the ear if it is on a flat face of
+            // the hull. Then a vertex strictly below orients the ear.
+            const int orientV = orient3d(pa, pb, pc, pv);
+            if (orientV == -1) {
+                continue;
+            }
+            bool isFace   = true;
+            bool oriented = (orientV == 1);
+            for (auto u : link) {
+                if (u == a || u == b || u == c) {
+                    continue;
+                }
+                const int orientU = orient3d(pa, pb, pc, mPositions[u]);
+                if (orientU == 1) {
+                    isFace = false;
+                    break;
+                }
+                oriented = oriented || (orientU == -1);
+            }
+            if (!isFace || !oriented) {
+                continue;
+            }
+
+            hole.push_back(a);
+            hole.push_back(b);
+            hole.push_back(c);
+            hole.push_back(v);
+            for (size_t j = i; j + 1 < ringSize; j++) {
+                ring[j] = ring[j + 1];
+            }
+            ringSize = (ringSize == 3) ? 0 : ringSize - 1;
+            clipped  = true;
+        }
+
+        if (!clipped) {
+            hole.resize(holeSize);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool DKHierarchy::findSilhouette(
+    const uint32_t v,
+    const Vec3&    y,
+    uint32_t&      left,
+    uint32_t&      right
+) const {
+    left  = INVALID_INDEX;
+    right = INVALID_INDEX;
+
+    const uint32_t start = mVertexTri[v];
+    uint32_t       t     = start;
+    do {
+        uint32_t k = 0;
+        while (mTriVertices[t * 3 + k] != v) {
+            k++;
+        }
+        const uint32_t he = t * 3 + k;
+        if (isSilhouette(he, y, true)) {
+            left = he;
+        }
+        else if (isSilhouette(he, y, false)) {
+            right = he;
+        }
+        t = mTriTwins[t * 3 + (k + 2) % 3] / 3;
+
+    } while (t != start);
+
+    return left != INVALID_INDEX && right != INVALID_INDEX;
+}
+
+
+uint32_t DKHierarchy::findHalfEdgeAround(
+    const uint32_t v,
+    const uint32_t src,
+    const uint32_t dst
+) const {
+    const uint32_t start = mVertexTri[v];
+    uint32_t       t     = start;
+    do {
+        uint32_t kv = 0;
+        for (uint32_t k = 0; k < 3; k++) {
+            const uint32_t he = t * 3 + k;
+            if (mTriVertices[he] == src && this->dst(he) == dst) {
+                return he;
+            }
+            if (mTriVertices[he] == v) {
+                kv = k;
+            }
+        }
+        t = mTriTwins[t * 3 + (kv + 2) % 3] / 3;
+
+    } while (t != start);
+
+    return INVALID_INDEX;
+}
+
+
+bool DKHierarchy::descendSilhouette(
+    const uint32_t v,
+    const uint32_t he,
+    const Vec3&    y,
+    const bool     leftSide,
+    uint32_t&      heBelow
+) const {
+
+    // The silhouette edge below is the same edge if it survives, or the
+    // edge to the vertex removed above one of the two triangles.
+    const uint32_t t     = he / 3;
+    const uint32_t tTwin = mTriTwins[he] / 3;
+    uint32_t       candidates[3];
+    size_t         numCandidates = 0;
+
+    if (mTriDown[t] != INVALID_INDEX) {
+        candidates[numCandidates++] = mTriDown[t] * 3 + he % 3;
+    }
+    else {
+        const uint32_t u = mTriBeyond[t];
+        candidates[numCandidates++] = findHalfEdgeAround(u, v, dst(he));
+        candidates[numCandidates++] = findHalfEdgeAround(u, v, u);
+    }
+    if (mTriDown[tTwin] == INVALID_INDEX) {
+        candidates[numCandidates++] = findHalfEdgeAround(
+                                 mTriBeyond[tTwin], v, mTriBeyond[tTwin]);
+    }
+
+    for (size_t i = 0; i < numCandidates; i++) {
+        if (candidates[i] != INVALID_INDEX &&
+            isSilhouette(candidates[i], y, leftSide)) {
+            heBelow = candidates[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+
+uint32_t DKHierarchy::descend(const Vec3& direction, bool& resolved)
+{
+    mStats.mNumQueries++;
+
+    uint32_t v      = mTopVertices[0];
+    double   height = mPositions[v].dot(direction);
+    for (auto u : mTopVertices) {
+        const double h = mPositions[u].dot(direction);
+        if (h > height) {
+            v      = u;
+            height = h;
+        }
+    }
+    mStats.mNumVerticesTested += mTopVertices.size();
+
+    // The silhouette is seen along y perpendicular to the direction.
+    // A direction off the axes avoids ties on the axis-aligned faces.
+    Vec3 y = direction.cross(Vec3(0.267261, 0.534522, 0.801784));
+    if (y.squaredNorm2() < 1.0e-6 * direction.squaredNorm2()) {
+        y = direction.cross(Vec3(0.801784, -0.267261, 0.534522));
+    }
+
+    uint32_t left, right;
+    if (!findSilhouette(v, y, left, right)) {
+        resolved = false;
+        return v;
+    }
+
+    for (long level = (long)numLevels() - 2; level >= 0; level--) {
+
+        // The extreme vertex below is v or a vertex removed above one of
+        // the triangles incident to the silhouette edges, and such a
+        // vertex is higher than v only if it is the extreme one.
+        uint32_t best       = v;
+        double   bestHeight = height;
+        for (auto he : { left, right }) {
+            for (auto t : { he / 3, mTriTwins[he] / 3 }) {
+                const uint32_t u = mTriBeyond[t];
+                if (u == INVALID_INDEX) {
+                    continue;
+                }
+                const double h = mPositions[u].dot(direction);
+                mStats.mNumVerticesTested++;
+                if (h > bestHeight) {
+                    best       = u;
+                    bestHeight = h;
+                }
+            }
+        }
+
+        if (best != v) {
+            v      = best;
+            height = bestHeight;
+            mStats.mNumSteps++;
+            if (!findSilhouette(v, y, left, right)) {
+                resolved = false;
+                return v;
+            }
+        }
+        else if (!descendSilhouette(v, left,  y, true,  left ) ||
+                 !descendSilhouette(v, right, y, false, right)   ) {
+            resolved = false;
+            return v;
+        }
+    }
+
+    resolved = true;
+    return v;
+}
+
+
+VertexIt DKHierarchy::findExtremeVertex(const Vec3& direction)
+{
+    if (empty()) {
+        return (mManifold != nullptr) ? mManifold->vertices().second
+                                      : VertexIt();
+    }
+
+    bool           resolved;
+    const uint32_t v = descend(direction, resolved);
+    if (!resolved) {
+        mNumFallbacks++;
+        return mManifold->findSupportVertex(direction, mVertexIts[v]);
+    }
+    return mVertexIts[v];
+}
+
+
+bool DKHierarchy::intersectsPlane(
+    const Vec3&  normal,
+    const double offset,
+    VertexIt&    lowest,
+    VertexIt&    highest
+) {
+    if (empty()) {
+        return false;
+    }
+    highest = findExtremeVertex(normal);
+    lowest  = findExtremeVertex(normal * -1.0);
+
+    return (*lowest )->pLCS().dot(normal) <= offset &&
+           (*highest)->pLCS().dot(normal) >= offset;
+}
+
+
+size_t DKHierarchy::memoryBytes() const
+{
+    return mPositions.capacity()      * sizeof(Vec3)     +
+           mVertexIts.capacity()      * sizeof(VertexIt) +
+           mVertexTri.capacity()      * sizeof(uint32_t) +
+           mTopVertices.capacity()    * sizeof(uint32_t) +
+           mTriVertices.capacity()    * sizeof(uint32_t) +
+           mTriTwins.capacity()       * sizeof(uint32_t) +
+           mTriDown.capacity()        * sizeof(uint32_t) +
+           mTriBeyond.capacity()      * sizeof(uint32_t) +
+           mLevelTriangles.capacity() * sizeof(uint32_t);
+}
+
+
+}// namespace Makena
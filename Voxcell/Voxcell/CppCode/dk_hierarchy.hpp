@@ -0,0 +1,408 @@
+#ifndef _MAKENA_DK_HIERARCHY_HPP_
+#define _MAKENA_DK_HIERARCHY_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "primitives.hpp"
+#include "manifold.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file dk_hierarchy.hpp
+ *
+ * @brief Dobkin-Kirkpatrick hierarchy of a convex Manifold for the
+ *        extreme vertex and the plane intersection queries in O(log n)
+ *        regardless of the degrees of the vertices.
+ *
+ *        Level 0 is the manifold with the faces triangulated. Level i+1
+ *        is made from level i by removing an independent set of the
+ *        vertices of degree at most MAX_REMOVAL_DEGREE and filling each
+ *        hole with the triangles of the convex hull of the rest. A constant
+ *        fraction of the vertices is removed per level, and hence there
+ *        are O(log n) levels whose total size and build time are O(n).
+ *
+ *        A query finds the extreme vertex of the top level by brute force
+ *        and descends the levels. It keeps the two silhouette edges at the
+ *        extreme vertex seen along a direction perpendicular to the query
+ *        direction, and the extreme vertex of the level below is either
+ *        the current one or a removed vertex above a triangle incident to
+ *        one of those edges. Each level takes O(1) time.
+ *
+ *        The triangles of all the levels are kept in one array, and the
+ *        triangles of level i are [mLevelTriangles[i], mLevelTriangles[i+1]).
+ *        The half edge k of the triangle t is indexed by t*3+k, and goes
+ *        from its k-th vertex to the next one.
+ *
+ *  @reference "Determining the separation of preprocessed polyhedra - a
+ *             unified approach", D. P. Dobkin and D. G. Kirkpatrick,
+ *             ICALP 1990, LNCS 443, pp. 400-413
+ *
+ *  @reference "Computational Geometry in C", J. O'Rourke,
+ *             2nd Ed, Cambridge University Press 1998, Section 7.10
+ */
+namespace Makena {
+
+using namespace std;
+
+
+class DKHierarchy {
+
+  public:
+
+    /** @brief index for no element such as the triangle below a triangle
+     *         made at its level.
+     */
+    static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+    /** @brief max degree of the vertices removed to make the next level.
+     */
+    static constexpr uint32_t MAX_REMOVAL_DEGREE = 8;
+
+    /** @brief the hierarchy stops at a level with at most this many
+     *         vertices.
+     */
+    static constexpr uint32_t MAX_TOP_VERTICES = 12;
+
+    inline DKHierarchy();
+    inline ~DKHierarchy();
+
+    /** @brief builds the hierarchy over the given manifold in O(n).
+     *         The previous contents are discarded.
+     *
+     *  @param m (in): the manifold. It must be convex and closed such as
+     *                 the one made by Manifold::findConvexHull(). It is not
+     *                 modified, but it must outlive this hierarchy as the
+     *                 queries return its vertices.
+     *
+     *  @return false if the manifold is not closed. This hierarchy is
+     *          left empty.
+     */
+    bool build(Manifold& m);
+
+    /** @brief resets this hierarchy to the empty state. */
+    inline void clear();
+
+    /** @brief returns true if nothing has been built. */
+    inline bool empty() const;
+
+    /** @brief finds a vertex farthest along the direction in O(log n).
+     *
+     *  @param direction (in): the direction in LCS. It need not be
+     *                         normalized.
+     *
+     *  @return the vertex of the manifold, or the end of the vertex list
+     *          if it is empty.
+     */
+    VertexIt findExtremeVertex(const Vec3& direction);
+
+    /** @brief tests if the plane intersects the manifold in O(log n).
+     *
+     *  @param normal  (in):  the normal of the plane in LCS.
+     *
+     *  @param offset  (in):  the plane is {x | normal.dot(x) == offset}.
+     *
+     *  @param lowest  (out): the vertex with the smallest normal.dot(x).
+     *
+     *  @param highest (out): the vertex with the largest normal.dot(x).
+     *
+     *  @return true if the plane touches or crosses the manifold.
+     */
+    bool intersectsPlane(
+        const Vec3&  normal,
+        const double offset,
+        VertexIt&    lowest,
+        VertexIt&    highest
+    );
+
+    inline uint32_t numLevels()    const;
+    inline uint32_t numVertices()  const;
+
+    /** @brief number of the triangles over all the levels. */
+    inline uint32_t numTriangles() const;
+
+    /** @brief number of the triangles of the level. Level 0 is the
+     *         triangulated manifold.
+     */
+    inline uint32_t numTriangles(const uint32_t level) const;
+
+    /** @brief number of the vertices of the top level. */
+    inline uint32_t numTopVertices() const;
+
+    /** @brief returns the bytes of the heap memory held by this hierarchy.
+     */
+    size_t memoryBytes() const;
+
+    /** @brief counters of the queries. A step is a move to a removed
+     *         vertex while descending, and the vertices tested are those
+     *         whose heights are evaluated.
+     */
+    inline const SupportStats& stats() const;
+
+    /** @brief number of the queries answered by hill-climbing on the
+     *         manifold as the silhouette became ambiguous in a degenerate
+     *         configuration.
+     */
+    inline long numFallbacks() const;
+
+    inline void clearStats();
+
+  private:
+
+    enum VertexMark {
+        VERTEX_FREE,
+        VERTEX_BLOCKED,
+        VERTEX_REMOVED
+    };
+
+    inline uint32_t dst(const uint32_t he) const;
+
+    /** @brief returns true if the unnormalized normal of the triangle
+     *         has a non-negative component along y.
+     */
+    inline bool facesAlong(const uint32_t t, const Vec3& y) const;
+
+    /** @brief returns true if the half edge is a silhouette edge along y
+     *         of the type given by leftSide.
+     */
+    inline bool isSilhouette(
+        const uint32_t he,
+        const Vec3&    y,
+        const bool     leftSide
+    ) const;
+
+    inline void pushTriangle(
+        const uint32_t v0,
+        const uint32_t v1,
+        const uint32_t v2,
+        const uint32_t down,
+        const uint32_t beyond
+    );
+
+    /** @brief sets mTriTwins for the triangles from begin to the end. */
+    bool linkTwins(const uint32_t begin);
+
+    /** @brief finds the adjacent vertices of v in the counter-clockwise
+     *         order seen from outside at the level of mVertexTri[v].
+     *
+     *  @return false if the degree exceeds MAX_REMOVAL_DEGREE.
+     */
+    bool findLink(const uint32_t v, vector<uint32_t>& link) const;
+
+    /** @brief triangulates the hole left by removing v by ear clipping.
+     *         Each ear must be a face of the convex hull of the remaining
+     *         vertices, i.e., v is not below it and the other adjacent
+     *         vertices are not above it.
+     *
+     *  @return false if no such triangulation is found. The triangles
+     *          are appended to hole otherwise as the quadruples of the
+     *          three vertices and v.
+     */
+    bool triangulateHole(
+        const uint32_t          v,
+        const vector<uint32_t>& link,
+        vector<uint32_t>&       hole
+    ) const;
+
+    /** @brief finds the two silhouette half edges going out of v by
+     *         walking around v at the level of mVertexTri[v].
+     */
+    bool findSilhouette(
+        const uint32_t v,
+        const Vec3&    y,
+        uint32_t&      left,
+        uint32_t&      right
+    ) const;
+
+    /** @brief finds the silhouette half edge going out of v at the level
+     *         below from the one at the current level when v stays the
+     *         extreme vertex.
+     */
+    bool descendSilhouette(
+        const uint32_t v,
+        const uint32_t he,
+        const Vec3&    y,
+        const bool     leftSide,
+        uint32_t&      heBelow
+    ) const;
+
+    /** @brief finds the half edge from src to dst among the triangles
+     *         around v at the level of mVertexTri[v].
+     */
+    uint32_t findHalfEdgeAround(
+        const uint32_t v,
+        const uint32_t src,
+        const uint32_t dst
+    ) const;
+
+    /** @brief descends the hierarchy for the extreme vertex.
+     *
+     *  @param resolved (out): false if the silhouette became ambiguous.
+     *                         The returned vertex is then the best one
+     *                         found so far.
+     */
+    uint32_t descend(const Vec3& direction, bool& resolved);
+
+    Manifold*        mManifold;
+
+    vector<Vec3>     mPositions;
+    vector<VertexIt> mVertexIts;
+
+    /** @brief a triangle incident to the vertex at the highest level
+     *         the vertex appears.
+     */
+    vector<uint32_t> mVertexTri;
+
+    vector<uint32_t> mTopVertices;
+
+    vector<uint32_t> mTriVertices;
+    vector<uint32_t> mTriTwins;
+
+    /** @brief the same triangle at the level below, or INVALID_INDEX if it
+     *         was made to fill a hole.
+     */
+    vector<uint32_t> mTriDown;
+
+    /** @brief the vertex removed from the level below above the triangle,
+     *         or INVALID_INDEX if it exists at the level below.
+     */
+    vector<uint32_t> mTriBeyond;
+
+    /** @brief offsets into the triangles. Its size is numLevels() + 1. */
+    vector<uint32_t> mLevelTriangles;
+
+    SupportStats     mStats;
+    long             mNumFallbacks;
+
+#ifdef UNIT_TESTS
+  friend class DKHierarchyTests;
+#endif
+
+};
+
+
+inline DKHierarchy::DKHierarchy():mManifold(nullptr),mNumFallbacks(0){;}
+
+
+inline DKHierarchy::~DKHierarchy(){;}
+
+
+inline void DKHierarchy::clear()
+{
+    mManifold = nullptr;
+    mPositions.clear();
+    mVertexIts.clear();
+    mVertexTri.clear();
+    mTopVertices.clear();
+    mTriVertices.clear();
+    mTriTwins.clear();
+    mTriDown.clear();
+    mTriBeyond.clear();
+    mLevelTriangles.clear();
+}
+
+
+inline bool DKHierarchy::empty() const
+{
+    return mTopVertices.empty();
+}
+
+
+inline uint32_t DKHierarchy::numLevels() const
+{
+    return mLevelTriangles.empty() ? 0 : (uint32_t)mLevelTriangles.size() - 1;
+}
+
+
+inline uint32_t DKHierarchy::numVertices() const
+{
+    return (uint32_t)mPositions.size();
+}
+
+
+inline uint32_t DKHierarchy::numTriangles() const
+{
+    return (uint32_t)mTriDown.size();
+}
+
+
+inline uint32_t DKHierarchy::numTriangles(const uint32_t level) const
+{
+    return mLevelTriangles[level + 1] - mLevelTriangles[level];
+}
+
+
+inline uint32_t DKHierarchy::numTopVertices() const
+{
+    return (uint32_t)mTopVertices.size();
+}
+
+
+inline const SupportStats& DKHierarchy::stats() const
+{
+    return mStats;
+}
+
+
+inline long DKHierarchy::numFallbacks() const
+{
+    return mNumFallbacks;
+}
+
+
+inline void DKHierarchy::clearStats()
+{
+    mStats.clear();
+    mNumFallbacks = 0;
+}
+
+
+inline uint32_t DKHierarchy::dst(const uint32_t he) const
+{
+    return mTriVertices[(he / 3) * 3 + (he % 3 + 1) % 3];
+}
+
+
+inline bool DKHierarchy::facesAlong(const uint32_t t, const Vec3& y) const
+{
+    const Vec3& p0 = mPositions[mTriVertices[t * 3]];
+    const Vec3& p1 = mPositions[mTriVertices[t * 3 + 1]];
+    const Vec3& p2 = mPositions[mTriVertices[t * 3 + 2]];
+    return (p1 - p0).cross(p2 - p0).dot(y) >= 0.0;
+}
+
+
+inline bool DKHierarchy::isSilhouette(
+    const uint32_t he,
+    const Vec3&    y,
+    const bool     leftSide
+) const {
+    const bool along     = facesAlong(he / 3, y);
+    const bool alongTwin = facesAlong(mTriTwins[he] / 3, y);
+    return leftSide ? (along && !alongTwin) : (!along && alongTwin);
+}
+
+
+inline void DKHierarchy::pushTriangle(
+    const uint32_t v0,
+    const uint32_t v1,
+    const uint32_t v2,
+    const uint32_t down,
+    const uint32_t beyond
+) {
+    mTriVertices.push_back(v0);
+    mTriVertices.push_back(v1);
+    mTriVertices.push_back(v2);
+    mTriDown.push_back(down);
+    mTriBeyond.push_back(beyond);
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_DK_HIERARCHY_HPP_*/
@@ -0,0 +1,293 @@
+#ifndef _MAKENA_FEATURE_INDEX_HPP_
+#define _MAKENA_FEATURE_INDEX_HPP_
+
+#include <cstdint>
+#include <climits>
+#include <utility>
+#include <vector>
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file feature_index.hpp
+ *
+ * @brief Lookup tables from the IDs of the features of a Manifold to the
+ *        features. They are rebuilt as a whole, and hence no erasure is
+ *        supported.
+ *
+ *        FeatureIdMap    : from a non-negative ID. It is a vector indexed
+ *                          by the ID if the IDs are compact, and an
+ *                          open-addressing hash table otherwise.
+ *
+ *        VertexPairMap   : from a pair of vertex IDs. It is an
+ *                          open-addressing hash table.
+ *
+ *        Both use linear probing on a power-of-two table at most half full.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief mixes the bits of the key for the hash tables. */
+inline uint64_t mixFeatureKey(uint64_t k)
+{
+    // The finalizer of MurmurHash3.
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+
+/** @brief returns the power-of-two table size for the number of entries.
+ */
+inline size_t featureTableSize(const size_t numEntries)
+{
+    size_t size = 16;
+    while (size < numEntries * 2) {
+        size *= 2;
+    }
+    return size;
+}
+
+
+template<class T>
+class FeatureIdMap {
+
+  public:
+
+    inline FeatureIdMap();
+
+    /** @brief discards the contents and prepares the table.
+     *
+     *  @param numEntries (in): the max number of entries to be inserted.
+     *
+     *  @param maxId      (in): the largest ID to be inserted.
+     */
+    inline void reset(const size_t numEntries, const long maxId);
+
+    inline void clear();
+
+    /** @brief inserts or overwrites the entry for the ID. */
+    inline void insert(const long id, const T& value);
+
+    /** @brief returns the value for the ID or nullptr if not found. */
+    inline const T* find(const long id) const;
+
+    inline size_t size() const;
+
+    /** @brief returns true if the table is indexed by the ID directly. */
+    inline bool isDense() const;
+
+  private:
+
+    static constexpr long EMPTY_KEY = LONG_MIN;
+
+    inline size_t slot(const long id) const;
+
+    bool          mDense;
+    size_t        mMask;
+    size_t        mSize;
+    vector<long>  mKeys;
+    vector<T>     mValues;
+};
+
+
+template<class T>
+class VertexPairMap {
+
+  public:
+
+    inline VertexPairMap();
+
+    /** @brief discards the contents and prepares the table.
+     *
+     *  @param numEntries (in): the max number of entries to be inserted.
+     */
+    inline void reset(const size_t numEntries);
+
+    inline void clear();
+
+    /** @brief inserts or overwrites the entry for the pair. */
+    inline void insert(const pair<long,long>& key, const T& value);
+
+    /** @brief returns the value for the pair or nullptr if not found. */
+    inline const T* find(const pair<long,long>& key) const;
+
+    inline size_t size() const;
+
+  private:
+
+    static constexpr long EMPTY_KEY = LONG_MIN;
+
+    inline size_t slot(const pair<long,long>& key) const;
+
+    size_t                  mMask;
+    size_t                  mSize;
+    vector<pair<long,long>> mKeys;
+    vector<T>               mValues;
+};
+
+
+template<class T>
+inline FeatureIdMap<T>::FeatureIdMap():
+    mDense(true),
+    mMask(0),
+    mSize(0){;}
+
+
+template<class T>
+inline void FeatureIdMap<T>::reset(const size_t numEntries, const long maxId)
+{
+    mSize = 0;
+
+    // The vector indexed by ID is used if at most 3/4 of it are unused.
+    mDense = (maxId < 0 || (size_t)maxId < numEntries * 4 + 16);
+    const size_t size = mDense ? (size_t)(maxId + 1)
+                               : featureTableSize(numEntries);
+    mMask = size - 1;
+    mKeys.assign(size, EMPTY_KEY);
+    mValues.resize(size);
+}
+
+
+template<class T>
+inline void FeatureIdMap<T>::clear()
+{
+    reset(0, -1);
+}
+
+
+template<class T>
+inline size_t FeatureIdMap<T>::slot(const long id) const
+{
+    if (mDense) {
+        return (size_t)id;
+    }
+    size_t s = (size_t)mixFeatureKey((uint64_t)id) & mMask;
+    while (mKeys[s] != EMPTY_KEY && mKeys[s] != id) {
+        s = (s + 1) & mMask;
+    }
+    return s;
+}
+
+
+template<class T>
+inline void FeatureIdMap<T>::insert(const long id, const T& value)
+{
+    const size_t s = slot(id);
+    if (mKeys[s] == EMPTY_KEY) {
+        mKeys[s] = id;
+        mSize++;
+    }
+    mValues[s] = value;
+}
+
+
+template<class T>
+inline const T* FeatureIdMap<T>::find(const long id) const
+{
+    if (id < 0 || (mDense && (size_t)id >= mKeys.size()) || mKeys.empty()) {
+        return nullptr;
+    }
+    const size_t s = slot(id);
+    return (mKeys[s] == id) ? &mValues[s] : nullptr;
+}
+
+
+template<class T>
+inline size_t FeatureIdMap<T>::size() const
+{
+    return mSize;
+}
+
+
+template<class T>
+inline bool FeatureIdMap<T>::isDense() const
+{
+    return mDense;
+}
+
+
+template<class T>
+inline VertexPairMap<T>::VertexPairMap():
+    mMask(0),
+    mSize(0){;}
+
+
+template<class T>
+inline void VertexPairMap<T>::reset(const size_t numEntries)
+{
+    mSize = 0;
+    const size_t size = featureTableSize(numEntries);
+    mMask = size - 1;
+    mKeys.assign(size, make_pair(EMPTY_KEY, EMPTY_KEY));
+    mValues.resize(size);
+}
+
+
+template<class T>
+inline void VertexPairMap<T>::clear()
+{
+    mSize = 0;
+    mMask = 0;
+    mKeys.clear();
+    mValues.clear();
+}
+
+
+template<class T>
+inline size_t VertexPairMap<T>::slot(const pair<long,long>& key) const
+{
+    const uint64_t h = mixFeatureKey(
+        ((uint64_t)key.first * 0x9e3779b97f4a7c15ULL) ^ (uint64_t)key.second);
+    size_t s = (size_t)h & mMask;
+    while (mKeys[s].first != EMPTY_KEY && mKeys[s] != key) {
+        s = (s + 1) & mMask;
+    }
+    return s;
+}
+
+
+template<class T>
+inline void VertexPairMap<T>::insert(
+    const pair<long,long>& key,
+    const T&               value
+) {
+    const size_t s = slot(key);
+    if (mKeys[s].first == EMPTY_KEY) {
+        mKeys[s] = key;
+        mSize++;
+    }
+    mValues[s] = value;
+}
+
+
+template<class T>
+inline const T* VertexPairMap<T>::find(const pair<long,long>& key) const
+{
+    if (mKeys.empty()) {
+        return nullptr;
+    }
+    const size_t s = slot(key);
+    return (mKeys[s] == key) ? &mValues[s] : nullptr;
+}
+
+
+template<class T>
+inline size_t VertexPairMap<T>::size() const
+{
+    return mSize;
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_FEATURE_INDEX_HPP_*/
@@ -0,0 +1,305 @@
+#ifndef _MAKENA_FEATURE_POOL_HPP_
+#define _MAKENA_FEATURE_POOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <list>
+#include <vector>
+#include <new>
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file feature_pool.hpp
+ *
+ * @brief Pool allocation for the features of a Manifold, i.e., Vertex,
+ *        Edge, HalfEdge, and Face, and the nodes of the lists that hold
+ *        them. The memory is taken from the chunks of fixed-size blocks,
+ *        and the freed blocks are recycled for the features of the same
+ *        size. The chunks are released all at once by FeaturePool::release().
+ *
+ *        The lists keep their usual semantics, and the iterators stay
+ *        valid until the element is erased.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @class FeaturePool
+ *
+ *  @brief pools of fixed-size blocks, one per block size.
+ *         It is not thread-safe, and it is owned by one Manifold.
+ */
+class FeaturePool {
+
+  public:
+
+    inline FeaturePool();
+    inline ~FeaturePool();
+
+    FeaturePool(const FeaturePool&) = delete;
+    FeaturePool& operator=(const FeaturePool&) = delete;
+    FeaturePool(FeaturePool&&) = delete;
+    FeaturePool& operator=(FeaturePool&&) = delete;
+
+    /** @brief returns a block of at least the given size. */
+    inline void* allocate(const size_t size);
+
+    /** @brief returns the block back to the pool for the given size. */
+    inline void deallocate(void* p, const size_t size);
+
+    /** @brief frees all the chunks. All the blocks must have been
+     *         deallocated.
+     */
+    inline void release();
+
+    /** @brief returns the number of blocks currently allocated. */
+    inline long numBlocksInUse() const;
+
+    /** @brief returns the number of bytes taken from the heap. */
+    inline size_t numBytesReserved() const;
+
+  private:
+
+    /** @brief number of blocks in a chunk. */
+    static constexpr size_t BLOCKS_PER_CHUNK = 256;
+
+    /** @brief the block sizes are multiples of this. */
+    static constexpr size_t BLOCK_ALIGNMENT  = alignof(max_align_t);
+
+    struct FreeBlock {
+        FreeBlock* mNext;
+    };
+
+    struct SizeClass {
+        size_t     mBlockSize;
+        FreeBlock* mFreeList;
+    };
+
+    inline static size_t roundUp(const size_t size);
+
+    inline SizeClass& findSizeClass(const size_t blockSize);
+
+    inline void addChunk(SizeClass& sc);
+
+    vector<SizeClass> mSizeClasses;
+    vector<void*>     mChunks;
+    size_t            mNumBytesReserved;
+    long              mNumBlocksInUse;
+
+#ifdef UNIT_TESTS
+  friend class FeaturePoolTests;
+#endif
+
+};
+
+
+/** @class FeatureAllocator
+ *
+ *  @brief allocator for the list nodes. It takes the blocks from the pool
+ *         if it is given, and from the heap otherwise.
+ */
+template<class T>
+class FeatureAllocator {
+
+  public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap            = true_type;
+
+    FeatureAllocator(FeaturePool* pool = nullptr) noexcept : mPool(pool){;}
+
+    template<class U>
+    FeatureAllocator(const FeatureAllocator<U>& rhs) noexcept
+        : mPool(rhs.mPool){;}
+
+    inline T* allocate(const size_t n);
+
+    inline void deallocate(T* p, const size_t n) noexcept;
+
+    template<class U>
+    bool operator==(const FeatureAllocator<U>& rhs) const noexcept
+        { return mPool == rhs.mPool; }
+
+    template<class U>
+    bool operator!=(const FeatureAllocator<U>& rhs) const noexcept
+        { return mPool != rhs.mPool; }
+
+  private:
+
+    FeaturePool* mPool;
+
+  template<class U> friend class FeatureAllocator;
+};
+
+
+/** @class FeatureDeleter
+ *
+ *  @brief deleter of the features. The feature is returned to the pool
+ *         if it is given, and deleted otherwise.
+ */
+template<class T>
+class FeatureDeleter {
+
+  public:
+
+    FeatureDeleter(FeaturePool* pool = nullptr) noexcept : mPool(pool){;}
+
+    inline void operator()(T* p) const noexcept;
+
+  private:
+
+    FeaturePool* mPool;
+};
+
+
+template<class T>
+using FeaturePtr  = unique_ptr<T, FeatureDeleter<T> >;
+
+template<class T>
+using FeatureList = list<FeaturePtr<T>, FeatureAllocator<FeaturePtr<T> > >;
+
+
+inline FeaturePool::FeaturePool():
+    mNumBytesReserved(0),
+    mNumBlocksInUse(0){;}
+
+
+inline FeaturePool::~FeaturePool()
+{
+    release();
+}
+
+
+inline size_t FeaturePool::roundUp(const size_t size)
+{
+    const size_t s = max(size, sizeof(FreeBlock));
+    return (s + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+}
+
+
+inline FeaturePool::SizeClass& FeaturePool::findSizeClass(
+    const size_t blockSize
+) {
+    // There are only a handful of the sizes.
+    for (auto& sc : mSizeClasses) {
+        if (sc.mBlockSize == blockSize) {
+            return sc;
+        }
+    }
+    mSizeClasses.push_back(SizeClass{blockSize, nullptr});
+    return mSizeClasses.back();
+}
+
+
+inline void FeaturePool::addChunk(SizeClass& sc)
+{
+    const size_t chunkSize = sc.mBlockSize * BLOCKS_PER_CHUNK;
+    mChunks.reserve(mChunks.size() + 1);
+    char* chunk = static_cast<char*>(::operator new(chunkSize));
+    mChunks.push_back(chunk);
+    mNumBytesReserved += chunkSize;
+
+    for (size_t i = BLOCKS_PER_CHUNK; i > 0; i--) {
+        auto* b = reinterpret_cast<FreeBlock*>(
+                                           chunk + (i - 1) * sc.mBlockSize);
+        b->mNext     = sc.mFreeList;
+        sc.mFreeList = b;
+    }
+}
+
+
+inline void* FeaturePool::allocate(const size_t size)
+{
+    auto& sc = findSizeClass(roundUp(size));
+    if (sc.mFreeList == nullptr) {
+        addChunk(sc);
+    }
+    FreeBlock* b = sc.mFreeList;
+    sc.mFreeList = b->mNext;
+    mNumBlocksInUse++;
+    return b;
+}
+
+
+inline void FeaturePool::deallocate(void* p, const size_t size)
+{
+    auto& sc = findSizeClass(roundUp(size));
+    auto* b  = static_cast<FreeBlock*>(p);
+    b->mNext     = sc.mFreeList;
+    sc.mFreeList = b;
+    mNumBlocksInUse--;
+}
+
+
+inline void FeaturePool::release()
+{
+    for (auto* c : mChunks) {
+        ::operator delete(c);
+    }
+    mChunks.clear();
+    mChunks.shrink_to_fit();
+    mSizeClasses.clear();
+    mNumBytesReserved = 0;
+    mNumBlocksInUse   = 0;
+}
+
+
+inline long FeaturePool::numBlocksInUse() const
+{
+    return mNumBlocksInUse;
+}
+
+
+inline size_t FeaturePool::numBytesReserved() const
+{
+    return mNumBytesReserved;
+}
+
+
+template<class T>
+inline T* FeatureAllocator<T>::allocate(const size_t n)
+{
+    if (mPool != nullptr && n == 1) {
+        return static_cast<T*>(mPool->allocate(sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+
+template<class T>
+inline void FeatureAllocator<T>::deallocate(T* p, const size_t n) noexcept
+{
+    if (mPool != nullptr && n == 1) {
+        mPool->deallocate(p, sizeof(T));
+    }
+    else {
+        ::operator delete(p);
+    }
+}
+
+
+template<class T>
+inline void FeatureDeleter<T>::operator()(T* p) const noexcept
+{
+    if (mPool != nullptr) {
+        p->~T();
+        mPool->deallocate(p, sizeof(T));
+    }
+    else {
+        delete p;
+    }
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_FEATURE_POOL_HPP_*/
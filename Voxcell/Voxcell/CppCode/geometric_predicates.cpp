@@ -0,0 +1,382 @@
+#include <cmath>
+
+#include "geometric_predicates.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file geometric_predicates.cpp
+ *
+ * @brief Orientation predicates with a floating-point filter and an exact
+ *        fallback on the arithmetic of floating-point expansions.
+ *
+ * @reference "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+ *             Geometric Predicates", J. R. Shewchuk, Discrete &
+ *             Computational Geometry 18(3), 1997
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief half of the machine epsilon of double (2^-53). */
+static constexpr double HALF_ULP = 1.1102230246251565e-16;
+
+/** @brief relative error bound of the double evaluation of orient3d. */
+static constexpr double O3D_ERR_BOUND = (7.0 + 56.0 * HALF_ULP) * HALF_ULP;
+
+/** @brief max number of the components of the exact determinant. */
+static constexpr int    MAX_EXPANSION = 192;
+
+
+/*
+ * An expansion is an array of doubles in the increasing order of magnitude
+ * whose components do not overlap. Its value is the exact sum of the
+ * components, and its sign is the sign of the last component.
+ * The zero components are eliminated.
+ */
+
+
+/** @brief x + y = a + b exactly. */
+static inline void twoSum(const double a, const double b, double& x, double& y)
+{
+    x = a + b;
+    const double bv = x - a;
+    const double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+
+/** @brief x + y = a + b exactly, given |a| >= |b|. */
+static inline void fastTwoSum(
+    const double a, const double b, double& x, double& y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+
+/** @brief x + y = a - b exactly. */
+static inline void twoDiff(const double a, const double b, double& x, double& y)
+{
+    x = a - b;
+    const double bv = a - x;
+    const double av = x + bv;
+    y = (a - av) + (bv - b);
+}
+
+
+/** @brief x + y = a * b exactly. */
+static inline void twoProduct(
+    const double a, const double b, double& x, double& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+
+/** @brief the expansion of a - b. */
+static inline int diffExpansion(const double a, const double b, double* h)
+{
+    double x, y;
+    twoDiff(a, b, x, y);
+    int hlen = 0;
+    if (y != 0.0) {
+        h[hlen++] = y;
+    }
+    if (x != 0.0 || hlen == 0) {
+        h[hlen++] = x;
+    }
+    return hlen;
+}
+
+
+/** @brief h += b in place. h must have room for one more component. */
+static inline int growExpansion(const int hlen, double* h, const double b)
+{
+    double Q = b;
+    int    hindex = 0;
+    for (int i = 0; i < hlen; i++) {
+        double Qnew, hh;
+        twoSum(Q, h[i], Qnew, hh);
+        Q = Qnew;
+        if (hh != 0.0) {
+            h[hindex++] = hh;
+        }
+    }
+    if (Q != 0.0 || hindex == 0) {
+        h[hindex++] = Q;
+    }
+    return hindex;
+}
+
+
+/** @brief h = e * b. h must have room for 2 * elen components. */
+static inline int scaleExpansion(
+    const int elen, const double* e, const double b, double* h)
+{
+    double Q, hh;
+    int    hindex = 0;
+    twoProduct(e[0], b, Q, hh);
+    if (hh != 0.0) {
+        h[hindex++] = hh;
+    }
+    for (int i = 1; i < elen; i++) {
+        double product1, product0, sum;
+        twoProduct(e[i], b, product1, product0);
+        twoSum(Q, product0, sum, hh);
+        if (hh != 0.0) {
+            h[hindex++] = hh;
+        }
+        fastTwoSum(product1, sum, Q, hh);
+        if (hh != 0.0) {
+            h[hindex++] = hh;
+        }
+    }
+    if (Q != 0.0 || hindex == 0) {
+        h[hindex++] = Q;
+    }
+    return hindex;
+}
+
+
+/** @brief h = e + f. h must have room for elen + flen components. */
+static inline int sumExpansions(
+    const int elen, const double* e, const int flen, const double* f,
+    double* h
+) {
+    int hlen = elen;
+    for (int i = 0; i < elen; i++) {
+        h[i] = e[i];
+    }
+    for (int j = 0; j < flen; j++) {
+        hlen = growExpansion(hlen, h, f[j]);
+    }
+    return hlen;
+}
+
+
+/** @brief h = e * f. h must have room for 2 * elen * flen components. */
+static inline int mulExpansions(
+    const int elen, const double* e, const int flen, const double* f,
+    double* h
+) {
+    double scaled[MAX_EXPANSION];
+    double sum   [MAX_EXPANSION];
+    int    hlen = 1;
+    h[0] = 0.0;
+    for (int j = 0; j < flen; j++) {
+        const int slen = scaleExpansion(elen, e, f[j], scaled);
+        hlen = sumExpansions(hlen, h, slen, scaled, sum);
+        for (int i = 0; i < hlen; i++) {
+            h[i] = sum[i];
+        }
+    }
+    return hlen;
+}
+
+
+/** @brief h = a1 * b1 - a2 * b2 for the expansions of 2 components. */
+static inline int minorExpansion(
+    const int a1len, const double* a1, const int b1len, const double* b1,
+    const int a2len, const double* a2, const int b2len, const double* b2,
+    double* h
+) {
+    double p1[8];
+    double p2[8];
+    const int p1len = mulExpansions(a1len, a1, b1len, b1, p1);
+    const int p2len = mulExpansions(a2len, a2, b2len, b2, p2);
+    for (int i = 0; i < p2len; i++) {
+        p2[i] = -p2[i];
+    }
+    return sumExpansions(p1len, p1, p2len, p2, h);
+}
+
+
+int orient3dExact(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d)
+{
+    double adx[2], ady[2], adz[2];
+    double bdx[2], bdy[2], bdz[2];
+    double cdx[2], cdy[2], cdz[2];
+    const int adxlen = diffExpansion(a.x(), d.x(), adx);
+    const int adylen = diffExpansion(a.y(), d.y(), ady);
+    const int adzlen = diffExpansion(a.z(), d.z(), adz);
+    const int bdxlen = diffExpansion(b.x(), d.x(), bdx);
+    const int bdylen = diffExpansion(b.y(), d.y(), bdy);
+    const int bdzlen = diffExpansion(b.z(), d.z(), bdz);
+    const int cdxlen = diffExpansion(c.x(), d.x(), cdx);
+    const int cdylen = diffExpansion(c.y(), d.y(), cdy);
+    const int cdzlen = diffExpansion(c.z(), d.z(), cdz);
+
+    double m1[16], m2[16], m3[16];
+    const int m1len = minorExpansion(bdxlen, bdx, cdylen, cdy,
+                                     cdxlen, cdx, bdylen, bdy, m1);
+    const int m2len = minorExpansion(cdxlen, cdx, adylen, ady,
+                                     adxlen, adx, cdylen, cdy, m2);
+    const int m3len = minorExpansion(adxlen, adx, bdylen, bdy,
+                                     bdxlen, bdx, adylen, ady, m3);
+
+    double t1[64], t2[64], t3[64];
+    const int t1len = mulExpansions(m1len, m1, adzlen, adz, t1);
+    const int t2len = mulExpansions(m2len, m2, bdzlen, bdz, t2);
+    const int t3len = mulExpansions(m3len, m3, cdzlen, cdz, t3);
+
+    double s12[128];
+    double det[MAX_EXPANSION];
+    const int s12len = sumExpansions(t1len,  t1,  t2len, t2, s12);
+    const int detlen = sumExpansions(s12len, s12, t3len, t3, det);
+
+    // The determinant above is positive if d is below the plane.
+    const double top = det[detlen - 1];
+    return (top < 0.0) ? 1 : ((top > 0.0) ? -1 : 0);
+}
+
+
+/** @brief the filter of orient3d(). Returns false if it can not decide. */
+static inline bool orient3dFilter(
+    const double ax, const double ay, const double az,
+    const double bx, const double by, const double bz,
+    const double cx, const double cy, const double cz,
+    const double dx, const double dy, const double dz,
+    int&         sign
+) {
+    const double adx = ax - dx, ady = ay - dy, adz = az - dz;
+    const double bdx = bx - dx, bdy = by - dy, bdz = bz - dz;
+    const double cdx = cx - dx, cdy = cy - dy, cdz = cz - dz;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    const double det = adz * (bdxcdy - cdxbdy)
+                     + bdz * (cdxady - adxcdy)
+                     + cdz * (adxbdy - bdxady);
+
+    const double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * fabs(adz)
+                           + (fabs(cdxady) + fabs(adxcdy)) * fabs(bdz)
+                           + (fabs(adxbdy) + fabs(bdxady)) * fabs(cdz);
+
+    const double errBound = O3D_ERR_BOUND * permanent;
+
+    sign = (det < 0.0) ? 1 : -1;
+    return (det > errBound) || (-det > errBound);
+}
+
+
+int orient3d(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d)
+{
+    int sign;
+    if (orient3dFilter(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(),
+                       c.x(), c.y(), c.z(), d.x(), d.y(), d.z(), sign)) {
+        return sign;
+    }
+    return orient3dExact(a, b, c, d);
+}
+
+
+long orient3dBlock(
+    const Vec3&    a,
+    const Vec3&    b,
+    const Vec3&    c,
+    const double*  xs,
+    const double*  ys,
+    const double*  zs,
+    const long     numPoints,
+    uint64_t&      positive,
+    uint64_t&      zero
+) {
+    positive = 0;
+    zero     = 0;
+    long numExact = 0;
+
+    for (long i = 0; i < numPoints; i++) {
+        int sign;
+        if (!orient3dFilter(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(),
+                            c.x(), c.y(), c.z(), xs[i], ys[i], zs[i], sign)) {
+            sign = orient3dExact(a, b, c, Vec3(xs[i], ys[i], zs[i]));
+            numExact++;
+        }
+        if (sign > 0) {
+            positive |= (1ULL << i);
+        }
+        else if (sign == 0) {
+            zero     |= (1ULL << i);
+        }
+    }
+    return numExact;
+}
+
+
+/** @brief ((b-a)x(c-a)).(d-a) in 64-bit integers. See ORIENT3D_INTEGER_LIMIT
+ *         for the bound of the coordinates.
+ */
+static inline int64_t orient3dIntegerDet(
+    const int64_t ax, const int64_t ay, const int64_t az,
+    const int64_t bx, const int64_t by, const int64_t bz,
+    const int64_t cx, const int64_t cy, const int64_t cz,
+    const int64_t dx, const int64_t dy, const int64_t dz
+) {
+    const int64_t abx = bx - ax, aby = by - ay, abz = bz - az;
+    const int64_t acx = cx - ax, acy = cy - ay, acz = cz - az;
+    const int64_t adx = dx - ax, ady = dy - ay, adz = dz - az;
+
+    return adx * (aby * acz - abz * acy)
+         + ady * (abz * acx - abx * acz)
+         + adz * (abx * acy - aby * acx);
+}
+
+
+static inline int signOf(const int64_t v)
+{
+    return (v > 0) ? 1 : ((v < 0) ? -1 : 0);
+}
+
+
+int orient3dInteger(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d)
+{
+    return signOf(orient3dIntegerDet(
+        (int64_t)a.x(), (int64_t)a.y(), (int64_t)a.z(),
+        (int64_t)b.x(), (int64_t)b.y(), (int64_t)b.z(),
+        (int64_t)c.x(), (int64_t)c.y(), (int64_t)c.z(),
+        (int64_t)d.x(), (int64_t)d.y(), (int64_t)d.z()));
+}
+
+
+void orient3dIntegerBlock(
+    const Vec3&    a,
+    const Vec3&    b,
+    const Vec3&    c,
+    const double*  xs,
+    const double*  ys,
+    const double*  zs,
+    const long     numPoints,
+    uint64_t&      positive,
+    uint64_t&      zero
+) {
+    const int64_t ax = (int64_t)a.x(), ay = (int64_t)a.y(), az = (int64_t)a.z();
+    const int64_t bx = (int64_t)b.x(), by = (int64_t)b.y(), bz = (int64_t)b.z();
+    const int64_t cx = (int64_t)c.x(), cy = (int64_t)c.y(), cz = (int64_t)c.z();
+
+    positive = 0;
+    zero     = 0;
+    for (long i = 0; i < numPoints; i++) {
+        const int64_t det = orient3dIntegerDet(ax, ay, az, bx, by, bz,
+                                               cx, cy, cz, (int64_t)xs[i],
+                                               (int64_t)ys[i], (int64_t)zs[i]);
+        if (det > 0) {
+            positive |= (1ULL << i);
+        }
+        else if (det == 0) {
+            zero     |= (1ULL << i);
+        }
+    }
+}
+
+
+}// namespace Makena
@@ -0,0 +1,106 @@
+#ifndef _MAKENA_GEOMETRIC_PREDICATES_HPP_
+#define _MAKENA_GEOMETRIC_PREDICATES_HPP_
+
+#include <cstdint>
+
+#include "primitives.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file geometric_predicates.hpp
+ *
+ * @brief Orientation predicates with a floating-point filter and an exact
+ *        fallback on the arithmetic of floating-point expansions.
+ *        The filter decides the sign in double precision if the magnitude
+ *        of the determinant exceeds its forward error bound. Otherwise
+ *        the determinant is evaluated exactly.
+ *
+ * @reference "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+ *             Geometric Predicates", J. R. Shewchuk, Discrete &
+ *             Computational Geometry 18(3), 1997
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief sign of the orientation of the point d relative to the plane
+ *         spanned by a, b, and c.
+ *
+ *  @return  1 : d is on the side the normal (b-a)x(c-a) points to, i.e.,
+ *               a, b, c are counter-clockwise seen from d.
+ *           0 : the 4 points are exactly coplanar.
+ *          -1 : d is on the other side.
+ */
+int orient3d(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d);
+
+
+/** @brief exact version of orient3d() without the filter. */
+int orient3dExact(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d);
+
+
+/** @brief orient3d() for a block of points given as SoA coordinates
+ *         against the plane spanned by a, b, and c.
+ *         Bit i of the masks corresponds to point i.
+ *
+ *  @param xs , ys, zs (in):  the coordinates of the points.
+ *
+ *  @param numPoints   (in):  the number of points. At most 64.
+ *
+ *  @param positive    (out): the points with orient3d() == 1.
+ *
+ *  @param zero        (out): the points with orient3d() == 0.
+ *
+ *  @return the number of points that needed the exact evaluation.
+ */
+long orient3dBlock(
+    const Vec3&    a,
+    const Vec3&    b,
+    const Vec3&    c,
+    const double*  xs,
+    const double*  ys,
+    const double*  zs,
+    const long     numPoints,
+    uint64_t&      positive,
+    uint64_t&      zero
+);
+
+
+/** @brief bound of the magnitude of the coordinates for orient3dInteger().
+ *         Below it the determinant fits in a 64-bit integer.
+ */
+static constexpr long ORIENT3D_INTEGER_LIMIT = 1L << 19;
+
+
+/** @brief orient3d() for the points with integer coordinates less than
+ *         ORIENT3D_INTEGER_LIMIT in magnitude. The determinant is evaluated
+ *         exactly in 64-bit integer arithmetic.
+ */
+int orient3dInteger(
+    const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d);
+
+
+/** @brief orient3dBlock() for the points with integer coordinates less than
+ *         ORIENT3D_INTEGER_LIMIT in magnitude.
+ */
+void orient3dIntegerBlock(
+    const Vec3&    a,
+    const Vec3&    b,
+    const Vec3&    c,
+    const double*  xs,
+    const double*  ys,
+    const double*  zs,
+    const long     numPoints,
+    uint64_t&      positive,
+    uint64_t&      zero
+);
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_GEOMETRIC_PREDICATES_HPP_*/
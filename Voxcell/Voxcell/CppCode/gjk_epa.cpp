@@ -0,0 +1,668 @@
+#include <cmath>
+
+#include "gjk_epa.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file gjk_epa.cpp
+ *
+ * @brief Distance and penetration depth between two convex Manifolds.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @class GJKSubSimplex
+ *
+ *  @brief the sub-simplex of the GJK simplex that contains the point
+ *         closest to the origin, and the barycentric coordinates of it.
+ */
+class GJKSubSimplex {
+  public:
+    long   mSize;
+    long   mIndices[4];
+    double mLambdas[4];
+    Vec3   mClosest;
+    double mDistance2;
+};
+
+
+static void closestOnSegment(
+    const GJKSupportPoint* s,
+    const long             i0,
+    const long             i1,
+    GJKSubSimplex&         sub
+) {
+    const Vec3&  a     = s[i0].mW;
+    const Vec3   ab    = s[i1].mW - a;
+    const double denom = ab.dot(ab);
+    const double t     = (denom > 0.0) ? -1.0 * a.dot(ab) / denom : 0.0;
+
+    if (t <= 0.0) {
+        sub.mSize       = 1;
+        sub.mIndices[0] = i0;
+        sub.mLambdas[0] = 1.0;
+        sub.mClosest    = a;
+    }
+    else if (t >= 1.0) {
+        sub.mSize       = 1;
+        sub.mIndices[0] = i1;
+        sub.mLambdas[0] = 1.0;
+        sub.mClosest    = s[i1].mW;
+    }
+    else {
+        sub.mSize       = 2;
+        sub.mIndices[0] = i0;
+        sub.mIndices[1] = i1;
+        sub.mLambdas[0] = 1.0 - t;
+        sub.mLambdas[1] = t;
+        sub.mClosest    = a + ab * t;
+    }
+    sub.mDistance2 = sub.mClosest.squaredNorm2();
+}
+
+
+/** @brief closest point on the triangle to the origin by the Voronoi
+ *         regions of the features.
+ *
+ *  @reference "Real-Time Collision Detection" C. Ericson
+ *             Section 5.1.5
+ */
+static void closestOnTriangle(
+    const GJKSupportPoint* s,
+    const long             i0,
+    const long             i1,
+    const long             i2,
+    GJKSubSimplex&         sub
+) {
+    const Vec3& a  = s[i0].mW;
+    const Vec3& b  = s[i1].mW;
+    const Vec3& c  = s[i2].mW;
+    const Vec3  ab = b - a;
+    const Vec3  ac = c - a;
+
+    const double d1 = -1.0 * ab.dot(a);
+    const double d2 = -1.0 * ac.dot(a);
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        closestOnSegment(s, i0, i0, sub);
+        return;
+    }
+
+    const double d3 = -1.0 * ab.dot(b);
+    const double d4 = -1.0 * ac.dot(b);
+    if (d3 >= 0.0 && d4 <= d3) {
+        closestOnSegment(s, i1, i1, sub);
+        return;
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        closestOnSegment(s, i0, i1, sub);
+        return;
+    }
+
+    const double d5 = -1.0 * ab.dot(c);
+    const double d6 = -1.0 * ac.dot(c);
+    if (d6 >= 0.0 && d5 <= d6) {
+        closestOnSegment(s, i2, i2, sub);
+        return;
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        closestOnSegment(s, i0, i2, sub);
+        return;
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        closestOnSegment(s, i1, i2, sub);
+        return;
+    }
+
+    const double denom = va + vb + vc;
+    if (denom <= 0.0) {
+        // Degenerate triangle. The closest of the edges is taken.
+        GJKSubSimplex edge;
+        closestOnSegment(s, i0, i1, sub);
+        closestOnSegment(s, i1, i2, edge);
+        if (edge.mDistance2 < sub.mDistance2) {
+            sub = edge;
+        }
+        closestOnSegment(s, i2, i0, edge);
+        if (edge.mDistance2 < sub.mDistance2) {
+            sub = edge;
+        }
+        return;
+    }
+
+    const double v = vb / denom;
+    const double w = vc / denom;
+    sub.mSize       = 3;
+    sub.mIndices[0] = i0;
+    sub.mIndices[1] = i1;
+    sub.mIndices[2] = i2;
+    sub.mLambdas[0] = 1.0 - v - w;
+    sub.mLambdas[1] = v;
+    sub.mLambdas[2] = w;
+    sub.mClosest    = a + ab * v + ac * w;
+    sub.mDistance2  = sub.mClosest.squaredNorm2();
+}
+
+
+/** @brief returns the sign of the orientation of p relative to the plane
+ *         of a, b, and c.
+ */
+static inline double planeSide(
+    const Vec3& p,
+    const Vec3& a,
+    const Vec3& b,
+    const Vec3& c
+) {
+    return (p - a).dot((b - a).cross(c - a));
+}
+
+
+void GJKSolver::setBodies(
+    Manifold&         A,
+    const Quaternion& qA,
+    const Vec3&       pA,
+    Manifold&         B,
+    const Quaternion& qB,
+    const Vec3&       pB
+) {
+    mA       = &A;
+    mB       = &B;
+    mRotA    = qA.rotationMatrix();
+    mRotB    = qB.rotationMatrix();
+    mInvRotA = mRotA.transpose();
+    mInvRotB = mRotB.transpose();
+    mPosA    = pA;
+    mPosB    = pB;
+    mLastA   = A.vertices().second;
+    mLastB   = B.vertices().second;
+}
+
+
+void GJKSolver::supportFromVertices(
+    const VertexIt&  vA,
+    const VertexIt&  vB,
+    GJKSupportPoint& sp
+) {
+    sp.mVertexA = vA;
+    sp.mVertexB = vB;
+    sp.mA       = mRotA * (*vA)->pLCS() + mPosA;
+    sp.mB       = mRotB * (*vB)->pLCS() + mPosB;
+    sp.mW       = sp.mA - sp.mB;
+}
+
+
+void GJKSolver::support(const Vec3& direction, GJKSupportPoint& sp)
+{
+    mNumSupportQueries++;
+
+    mLastA = mA->findSupportVertex(mInvRotA * direction, mLastA);
+    mLastB = mB->findSupportVertex(mInvRotB * (direction * -1.0), mLastB);
+    supportFromVertices(mLastA, mLastB, sp);
+}
+
+
+bool GJKSolver::reduceSimplex()
+{
+    GJKSubSimplex sub;
+
+    switch (mSimplexSize) {
+
+      case 1:
+        closestOnSegment(mSimplex, 0, 0, sub);
+        break;
+
+      case 2:
+        closestOnSegment(mSimplex, 0, 1, sub);
+        break;
+
+      case 3:
+        closestOnTriangle(mSimplex, 0, 1, 2, sub);
+        break;
+
+      default: {
+        const Vec3& w0  = mSimplex[0].mW;
+        const Vec3& w1  = mSimplex[1].mW;
+        const Vec3& w2  = mSimplex[2].mW;
+        const Vec3& w3  = mSimplex[3].mW;
+        const Vec3  zero(0.0, 0.0, 0.0);
+
+        // The faces and the vertices opposite to them.
+        const long faces[4][4] = { {0, 1, 2, 3}, {0, 3, 1, 2},
+                                   {0, 2, 3, 1}, {1, 3, 2, 0}  };
+        const bool flat = fabs(planeSide(w3, w0, w1, w2)) <=
+                          1.0e-12 * (w1 - w0).squaredNorm2() *
+                                    sqrt((w3 - w0).squaredNorm2());
+        bool inside = !flat;
+        sub.mDistance2 = -1.0;
+        for (auto& f : faces) {
+            const Vec3& a = mSimplex[f[0]].mW;
+            const Vec3& b = mSimplex[f[1]].mW;
+            const Vec3& c = mSimplex[f[2]].mW;
+            const Vec3& d = mSimplex[f[3]].mW;
+            if (!flat && planeSide(zero, a, b, c) * planeSide(d, a, b, c)
+                                                                    >= 0.0) {
+                continue;
+            }
+            inside = false;
+            GJKSubSimplex face;
+            closestOnTriangle(mSimplex, f[0], f[1], f[2], face);
+            if (sub.mDistance2 < 0.0 || face.mDistance2 < sub.mDistance2) {
+                sub = face;
+            }
+        }
+        if (inside) {
+            for (long i = 0; i < 4; i++) {
+                mLambdas[i] = 0.0;
+            }
+            mClosest = zero;
+            return true;
+        }
+        break;
+      }
+    }
+
+    GJKSupportPoint reduced[4];
+    for (long i = 0; i < sub.mSize; i++) {
+        reduced[i]  = mSimplex[sub.mIndices[i]];
+        mLambdas[i] = sub.mLambdas[i];
+    }
+    for (long i = 0; i < sub.mSize; i++) {
+        mSimplex[i] = reduced[i];
+    }
+    mSimplexSize = sub.mSize;
+    mClosest     = sub.mClosest;
+    return false;
+}
+
+
+bool GJKSolver::runGJK(GJKSimplex& simplex)
+{
+    if (simplex.mSize > 0) {
+        for (long i = 0; i < simplex.mSize; i++) {
+            supportFromVertices(
+                    simplex.mVerticesA[i], simplex.mVerticesB[i], mSimplex[i]);
+        }
+        mSimplexSize = simplex.mSize;
+        mLastA       = simplex.mVerticesA[simplex.mSize - 1];
+        mLastB       = simplex.mVerticesB[simplex.mSize - 1];
+    }
+    else {
+        Vec3 direction = mPosA - mPosB;
+        if (direction.squaredNorm2() == 0.0) {
+            direction = Vec3(1.0, 0.0, 0.0);
+        }
+        support(direction, mSimplex[0]);
+        mSimplexSize = 1;
+    }
+
+    double scale2 = 0.0;
+    for (long i = 0; i < mSimplexSize; i++) {
+        scale2 = max(scale2, mSimplex[i].mW.squaredNorm2());
+    }
+
+    bool   overlapping = false;
+    double prevDist2   = -1.0;
+    for (long iter = 0; iter < mMaxIterations; iter++) {
+
+        mNumGJKIterations++;
+
+        if (reduceSimplex()) {
+            overlapping = true;
+            break;
+        }
+        const double dist2 = mClosest.squaredNorm2();
+        if (dist2 <= mTolerance * mTolerance * scale2) {
+            overlapping = true;
+            break;
+        }
+        if (prevDist2 >= 0.0 && dist2 >= prevDist2) {
+            // No progress by the rounding errors.
+            break;
+        }
+        prevDist2 = dist2;
+
+        GJKSupportPoint sp;
+        support(mClosest * -1.0, sp);
+        scale2 = max(scale2, sp.mW.squaredNorm2());
+
+        if (dist2 - mClosest.dot(sp.mW) <= mTolerance * dist2) {
+            break;
+        }
+        bool duplicate = false;
+        for (long i = 0; i < mSimplexSize; i++) {
+            if (mSimplex[i].mVertexA == sp.mVertexA &&
+                mSimplex[i].mVertexB == sp.mVertexB    ) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
+            break;
+        }
+        mSimplex[mSimplexSize++] = sp;
+    }
+
+    simplex.mSize = mSimplexSize;
+    for (long i = 0; i < mSimplexSize; i++) {
+        simplex.mVerticesA[i] = mSimplex[i].mVertexA;
+        simplex.mVerticesB[i] = mSimplex[i].mVertexB;
+    }
+    return overlapping;
+}
+
+
+bool GJKSolver::findDistance(
+    Manifold&         A,
+    const Quaternion& qA,
+    const Vec3&       pA,
+    Manifold&         B,
+    const Quaternion& qB,
+    const Vec3&       pB,
+    GJKSimplex&       simplex,
+    double&           distance,
+    Vec3&             pointA,
+    Vec3&             pointB
+) {
+    distance = 0.0;
+    if (A.vertices().first == A.vertices().second ||
+        B.vertices().first == B.vertices().second    ) {
+        return false;
+    }
+    setBodies(A, qA, pA, B, qB, pB);
+
+    const bool overlapping = runGJK(simplex);
+
+    pointA.zero();
+    pointB.zero();
+    for (long i = 0; i < mSimplexSize; i++) {
+        pointA = pointA + mSimplex[i].mA * mLambdas[i];
+        pointB = pointB + mSimplex[i].mB * mLambdas[i];
+    }
+    if (overlapping) {
+        return false;
+    }
+    distance = mClosest.norm2();
+    return true;
+}
+
+
+bool GJKSolver::findPenetration(
+    Manifold&         A,
+    const Quaternion& qA,
+    const Vec3&       pA,
+    Manifold&         B,
+    const Quaternion& qB,
+    const Vec3&       pB,
+    GJKSimplex&       simplex,
+    double&           depth,
+    Vec3&             normal,
+    Vec3&             pointA,
+    Vec3&             pointB
+) {
+    double distance;
+    if (findDistance(A, qA, pA, B, qB, pB, simplex, distance, pointA, pointB))
+    {
+        depth  = -1.0 * distance;
+        normal = (pointB - pointA) * (1.0 / distance);
+        return false;
+    }
+    if (mA == nullptr || mSimplexSize == 0) {
+        depth = 0.0;
+        normal.zero();
+        return false;
+    }
+
+    if (!runEPA(depth, normal, pointA, pointB)) {
+        // Touching. The penetration is zero.
+        depth  = 0.0;
+        normal = mPosB - mPosA;
+        if (normal.squaredNorm2() > 0.0) {
+            normal.normalize();
+        }
+    }
+    return true;
+}
+
+
+void GJKSolver::addEPAFace(const long i0, const long i1, const long i2)
+{
+    EPAFace f;
+    f.mVertices[0] = i0;
+    f.mVertices[1] = i1;
+    f.mVertices[2] = i2;
+    f.mRemoved     = false;
+
+    const Vec3& w0 = mEPAVertices[i0].mW;
+    Vec3 n = (mEPAVertices[i1].mW - w0).cross(mEPAVertices[i2].mW - w0);
+    const double len = n.norm2();
+    if (len > 0.0) {
+        n.scale(1.0 / len);
+        f.mDistance = n.dot(w0);
+    }
+    else {
+        // Degenerate. It is never selected nor removed.
+        f.mDistance = HUGE_VAL;
+    }
+    f.mNormal = n;
+    mEPAFaces.push_back(f);
+}
+
+
+bool GJKSolver::makeInitialTetrahedron()
+{
+    mEPAVertices.clear();
+    mEPAFaces.clear();
+    for (long i = 0; i < mSimplexSize; i++) {
+        mEPAVertices.push_back(mSimplex[i]);
+    }
+
+    double scale2 = 0.0;
+    for (auto& v : mEPAVertices) {
+        scale2 = max(scale2, v.mW.squaredNorm2());
+    }
+    const double eps = 1.0e-10 * sqrt(scale2 > 0.0 ? scale2 : 1.0);
+
+    GJKSupportPoint sp;
+    if (mEPAVertices.size() == 1) {
+        const Vec3 axes[6] = { Vec3( 1.0, 0.0, 0.0), Vec3(-1.0, 0.0, 0.0),
+                               Vec3( 0.0, 1.0, 0.0), Vec3( 0.0,-1.0, 0.0),
+                               Vec3( 0.0, 0.0, 1.0), Vec3( 0.0, 0.0,-1.0) };
+        for (auto& axis : axes) {
+            support(axis, sp);
+            if ((sp.mW - mEPAVertices[0].mW).norm2() > eps) {
+                mEPAVertices.push_back(sp);
+                break;
+            }
+        }
+    }
+
+    if (mEPAVertices.size() == 2) {
+        // Search around the segment for a point off the line.
+        Vec3 d = mEPAVertices[1].mW - mEPAVertices[0].mW;
+        d.normalize();
+        Vec3 p = d.perp();
+        p.normalize();
+        const Vec3 q = d.cross(p);
+        for (long k = 0; k < 6; k++) {
+            const double theta = M_PI * k / 3.0;
+            support(p * cos(theta) + q * sin(theta), sp);
+            const Vec3 r = sp.mW - mEPAVertices[0].mW;
+            if (r.cross(d).norm2() > eps) {
+                mEPAVertices.push_back(sp);
+                break;
+            }
+        }
+    }
+
+    if (mEPAVertices.size() == 3) {
+        const Vec3& w0 = mEPAVertices[0].mW;
+        Vec3 n = (mEPAVertices[1].mW - w0).cross(mEPAVertices[2].mW - w0);
+        n.normalize();
+        support(n, sp);
+        if (fabs(n.dot(sp.mW - w0)) <= eps) {
+            support(n * -1.0, sp);
+        }
+        if (fabs(n.dot(sp.mW - w0)) > eps) {
+            mEPAVertices.push_back(sp);
+        }
+    }
+
+    if (mEPAVertices.size() != 4) {
+        return false;
+    }
+
+    const Vec3& w0 = mEPAVertices[0].mW;
+    const Vec3& w1 = mEPAVertices[1].mW;
+    const Vec3& w2 = mEPAVertices[2].mW;
+    const Vec3& w3 = mEPAVertices[3].mW;
+    const double side = planeSide(w3, w0, w1, w2);
+    if (fabs(side) <= eps * eps * eps) {
+        return false;
+    }
+
+    // Oriented such that the normals point away from the opposite vertex.
+    if (side < 0.0) {
+        addEPAFace(0, 1, 2);
+        addEPAFace(0, 3, 1);
+        addEPAFace(0, 2, 3);
+        addEPAFace(1, 3, 2);
+    }
+    else {
+        addEPAFace(0, 2, 1);
+        addEPAFace(0, 1, 3);
+        addEPAFace(0, 3, 2);
+        addEPAFace(1, 2, 3);
+    }
+    return true;
+}
+
+
+bool GJKSolver::runEPA(
+    double& depth,
+    Vec3&   normal,
+    Vec3&   pointA,
+    Vec3&   pointB
+) {
+    if (!makeInitialTetrahedron()) {
+        return false;
+    }
+
+    double scale = 0.0;
+    for (auto& v : mEPAVertices) {
+        scale = max(scale, v.mW.norm2());
+    }
+
+    long best = 0;
+    for (long iter = 0; iter < mMaxIterations; iter++) {
+
+        mNumEPAIterations++;
+
+        best = -1;
+        for (long i = 0; i < (long)mEPAFaces.size(); i++) {
+            if (!mEPAFaces[i].mRemoved && (best == -1 ||
+                mEPAFaces[i].mDistance < mEPAFaces[best].mDistance)) {
+                best = i;
+            }
+        }
+
+        const Vec3 n = mEPAFaces[best].mNormal;
+        GJKSupportPoint sp;
+        support(n, sp);
+        if (sp.mW.dot(n) - mEPAFaces[best].mDistance <= mTolerance * scale) {
+            break;
+        }
+        bool duplicate = false;
+        for (auto& v : mEPAVertices) {
+            if (v.mVertexA == sp.mVertexA && v.mVertexB == sp.mVertexB) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
+            break;
+        }
+
+        // Remove the faces visible from the new vertex, and cover the
+        // hole bounded by the horizon with the new faces.
+        const long newIndex = (long)mEPAVertices.size();
+        mEPAVertices.push_back(sp);
+        mEPAHorizon.clear();
+        for (auto& f : mEPAFaces) {
+            if (f.mRemoved ||
+                f.mNormal.dot(sp.mW - mEPAVertices[f.mVertices[0]].mW) <= 0.0)
+            {
+                continue;
+            }
+            f.mRemoved = true;
+            for (long k = 0; k < 3; k++) {
+                const long i0 = f.mVertices[k];
+                const long i1 = f.mVertices[(k + 1) % 3];
+                bool shared = false;
+                for (auto& e : mEPAHorizon) {
+                    if (e.first == i1 && e.second == i0) {
+                        e = mEPAHorizon.back();
+                        mEPAHorizon.pop_back();
+                        shared = true;
+                        break;
+                    }
+                }
+                if (!shared) {
+                    mEPAHorizon.push_back(make_pair(i0, i1));
+                }
+            }
+        }
+        for (auto& e : mEPAHorizon) {
+            addEPAFace(e.first, e.second, newIndex);
+        }
+        best = -1;
+    }
+
+    if (best == -1) {
+        for (long i = 0; i < (long)mEPAFaces.size(); i++) {
+            if (!mEPAFaces[i].mRemoved && (best == -1 ||
+                mEPAFaces[i].mDistance < mEPAFaces[best].mDistance)) {
+                best = i;
+            }
+        }
+    }
+
+    // The barycentric coordinates of the projection of the origin onto
+    // the face give the points on the bodies.
+    const EPAFace&         f  = mEPAFaces[best];
+    const GJKSupportPoint& s0 = mEPAVertices[f.mVertices[0]];
+    const GJKSupportPoint& s1 = mEPAVertices[f.mVertices[1]];
+    const GJKSupportPoint& s2 = mEPAVertices[f.mVertices[2]];
+    const Vec3   p   = f.mNormal * f.mDistance;
+    const Vec3   v0  = s1.mW - s0.mW;
+    const Vec3   v1  = s2.mW - s0.mW;
+    const Vec3   v2  = p     - s0.mW;
+    const double d00 = v0.dot(v0);
+    const double d01 = v0.dot(v1);
+    const double d11 = v1.dot(v1);
+    const double d20 = v2.dot(v0);
+    const double d21 = v2.dot(v1);
+    const double den = d00 * d11 - d01 * d01;
+    const double l1  = (den != 0.0) ? (d11 * d20 - d01 * d21) / den : 0.0;
+    const double l2  = (den != 0.0) ? (d00 * d21 - d01 * d20) / den : 0.0;
+    const double l0  = 1.0 - l1 - l2;
+
+    depth  = f.mDistance;
+    normal = f.mNormal;
+    pointA = s0.mA * l0 + s1.mA * l1 + s2.mA * l2;
+    pointB = s0.mB * l0 + s1.mB * l1 + s2.mB * l2;
+    return true;
+}
+
+
+}// namespace Makena
@@ -0,0 +1,364 @@
+#ifndef _MAKENA_GJK_EPA_HPP_
+#define _MAKENA_GJK_EPA_HPP_
+
+#include <utility>
+#include <vector>
+
+#include "primitives.hpp"
+#include "quaternion.hpp"
+#include "manifold.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file gjk_epa.hpp
+ *
+ * @brief Distance and penetration depth between two convex Manifolds
+ *        placed in the world by rigid transforms.
+ *
+ *        The distance and the closest points are found by GJK over the
+ *        Minkowski difference A - B. The support points are found by
+ *        Manifold::findSupportVertex(), i.e., by hill-climbing on the
+ *        vertex adjacency from the previous support vertex. If the bodies
+ *        overlap, the penetration depth is found by EPA from the final
+ *        simplex of GJK.
+ *
+ *        The final simplex is kept in GJKSimplex per pair of bodies, and
+ *        the next query for the pair starts from it. For the bodies that
+ *        move a little per frame, GJK then terminates in a few iterations.
+ *
+ *        A transform (q, p) maps a point x in LCS of the body to
+ *        q.rotate(x) + p in the world. q must be a unit quaternion.
+ *
+ * @reference "A Fast and Robust GJK Implementation for Collision Detection
+ *            of Convex Objects", G. van den Bergen, Journal of Graphics
+ *            Tools 4(2), 1999
+ *
+ * @reference "Real-Time Collision Detection" C. Ericson
+ *            Morgan Kaufmann 2005, ISBN 1-55860-732-3, Section 9.5
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @class GJKSimplex
+ *
+ *  @brief the simplex of the last GJK query for a pair of bodies, kept by
+ *         the caller to warm-start the next query for the same pair.
+ *         It refers to the vertices of the manifolds, and it must be
+ *         cleared when the manifolds are modified.
+ */
+class GJKSimplex {
+
+  public:
+
+    inline GJKSimplex();
+
+    /** @brief forgets the simplex. The next query starts cold. */
+    inline void clear();
+
+    /** @brief number of the vertices of the simplex, up to 4. */
+    inline long size() const;
+
+  private:
+
+    long     mSize;
+    VertexIt mVerticesA[4];
+    VertexIt mVerticesB[4];
+
+  friend class GJKSolver;
+};
+
+
+/* @class GJKSupportPoint
+ *
+ * @brief a vertex of the Minkowski difference w = a - b, where a and b are
+ *        the vertices of the bodies in the world.
+ */
+class GJKSupportPoint {
+  public:
+    Vec3     mW;
+    Vec3     mA;
+    Vec3     mB;
+    VertexIt mVertexA;
+    VertexIt mVertexB;
+};
+
+
+/* @class EPAFace
+ *
+ * @brief a triangle of the polytope expanded by EPA. The vertices are
+ *        counter-clockwise seen from outside.
+ */
+class EPAFace {
+  public:
+    long   mVertices[3];
+
+    /** @brief unit outward normal */
+    Vec3   mNormal;
+
+    /** @brief distance from the origin to the plane of the face */
+    double mDistance;
+
+    bool   mRemoved;
+};
+
+
+class GJKSolver {
+
+  public:
+
+    inline GJKSolver();
+    inline ~GJKSolver();
+
+    /** @brief sets the relative tolerance of the termination.
+     *         The default is 1.0e-9.
+     */
+    inline void setTolerance(const double tolerance);
+
+    /** @brief sets the max number of iterations of GJK and EPA each.
+     *         The default is 64.
+     */
+    inline void setMaxIterations(const long maxIterations);
+
+    /** @brief finds the distance and the closest points between the two
+     *         convex bodies.
+     *
+     *  @param A        (in):     convex manifold of the body A
+     *
+     *  @param qA       (in):     rotation of A
+     *
+     *  @param pA       (in):     translation of A
+     *
+     *  @param B        (in):     convex manifold of the body B
+     *
+     *  @param qB       (in):     rotation of B
+     *
+     *  @param pB       (in):     translation of B
+     *
+     *  @param simplex  (in/out): the simplex of the previous query for
+     *                            the pair, which is updated.
+     *
+     *  @param distance (out):    the distance
+     *
+     *  @param pointA   (out):    the closest point on A in the world
+     *
+     *  @param pointB   (out):    the closest point on B in the world
+     *
+     *  @return false if the bodies overlap. distance is 0 then.
+     */
+    bool findDistance(
+        Manifold&         A,
+        const Quaternion& qA,
+        const Vec3&       pA,
+        Manifold&         B,
+        const Quaternion& qB,
+        const Vec3&       pB,
+        GJKSimplex&       simplex,
+        double&           distance,
+        Vec3&             pointA,
+        Vec3&             pointB
+    );
+
+    /** @brief finds the penetration depth of the two convex bodies, i.e.,
+     *         the shortest translation of B that makes them touch.
+     *
+     *  @param A, qA, pA, B, qB, pB, simplex (in): same as findDistance().
+     *
+     *  @param depth    (out): the penetration depth
+     *
+     *  @param normal   (out): unit direction from A to B. Translating B by
+     *                         depth along it makes them touch.
+     *
+     *  @param pointA   (out): the deepest point of A in B in the world
+     *
+     *  @param pointB   (out): the deepest point of B in A in the world
+     *
+     *  @return false if the bodies do not overlap. depth is then the
+     *          negated distance, and pointA and pointB are the closest
+     *          points.
+     */
+    bool findPenetration(
+        Manifold&         A,
+        const Quaternion& qA,
+        const Vec3&       pA,
+        Manifold&         B,
+        const Quaternion& qB,
+        const Vec3&       pB,
+        GJKSimplex&       simplex,
+        double&           depth,
+        Vec3&             normal,
+        Vec3&             pointA,
+        Vec3&             pointB
+    );
+
+    inline long numGJKIterations()  const;
+    inline long numEPAIterations()  const;
+    inline long numSupportQueries() const;
+    inline void clearStats();
+
+  private:
+
+    void setBodies(
+        Manifold&         A,
+        const Quaternion& qA,
+        const Vec3&       pA,
+        Manifold&         B,
+        const Quaternion& qB,
+        const Vec3&       pB
+    );
+
+    /** @brief finds the support point of A - B along the direction in the
+     *         world.
+     */
+    void support(const Vec3& direction, GJKSupportPoint& sp);
+
+    /** @brief makes the support point from the vertices of A and B. */
+    void supportFromVertices(
+        const VertexIt&  vA,
+        const VertexIt&  vB,
+        GJKSupportPoint& sp
+    );
+
+    /** @brief runs GJK from the simplex.
+     *
+     *  @return true if the origin is in the simplex, i.e., the bodies
+     *          overlap. Otherwise mClosest is the closest point of A - B
+     *          to the origin.
+     */
+    bool runGJK(GJKSimplex& simplex);
+
+    /** @brief reduces mSimplex to the smallest sub-simplex that contains
+     *         the point closest to the origin, and sets mClosest and
+     *         mLambdas.
+     *
+     *  @return true if the origin is in the tetrahedron.
+     */
+    bool reduceSimplex();
+
+    /** @brief runs EPA from mSimplex that contains the origin.
+     *
+     *  @return false if it failed to make the initial tetrahedron, i.e.,
+     *          the bodies are only touching.
+     */
+    bool runEPA(
+        double& depth,
+        Vec3&   normal,
+        Vec3&   pointA,
+        Vec3&   pointB
+    );
+
+    bool makeInitialTetrahedron();
+
+    void addEPAFace(const long i0, const long i1, const long i2);
+
+    Manifold*               mA;
+    Manifold*               mB;
+    Mat3x3                  mRotA;
+    Mat3x3                  mRotB;
+    Mat3x3                  mInvRotA;
+    Mat3x3                  mInvRotB;
+    Vec3                    mPosA;
+    Vec3                    mPosB;
+    VertexIt                mLastA;
+    VertexIt                mLastB;
+
+    double                  mTolerance;
+    long                    mMaxIterations;
+
+    GJKSupportPoint         mSimplex[4];
+    double                  mLambdas[4];
+    long                    mSimplexSize;
+    Vec3                    mClosest;
+
+    /** @brief work memory of EPA kept for reuse. */
+    vector<GJKSupportPoint> mEPAVertices;
+    vector<EPAFace>         mEPAFaces;
+    vector<pair<long,long>> mEPAHorizon;
+
+    long                    mNumGJKIterations;
+    long                    mNumEPAIterations;
+    long                    mNumSupportQueries;
+
+#ifdef UNIT_TESTS
+  friend class GJKSolverTests;
+#endif
+
+};
+
+
+inline GJKSimplex::GJKSimplex():mSize(0){;}
+
+
+inline void GJKSimplex::clear()
+{
+    mSize = 0;
+}
+
+
+inline long GJKSimplex::size() const
+{
+    return mSize;
+}
+
+
+inline GJKSolver::GJKSolver():
+    mA(nullptr),
+    mB(nullptr),
+    mTolerance(1.0e-9),
+    mMaxIterations(64),
+    mSimplexSize(0),
+    mNumGJKIterations(0),
+    mNumEPAIterations(0),
+    mNumSupportQueries(0){;}
+
+
+inline GJKSolver::~GJKSolver(){;}
+
+
+inline void GJKSolver::setTolerance(const double tolerance)
+{
+    mTolerance = tolerance;
+}
+
+
+inline void GJKSolver::setMaxIterations(const long maxIterations)
+{
+    mMaxIterations = maxIterations;
+}
+
+
+inline long GJKSolver::numGJKIterations() const
+{
+    return mNumGJKIterations;
+}
+
+
+inline long GJKSolver::numEPAIterations() const
+{
+    return mNumEPAIterations;
+}
+
+
+inline long GJKSolver::numSupportQueries() const
+{
+    return mNumSupportQueries;
+}
+
+
+inline void GJKSolver::clearStats()
+{
+    mNumGJKIterations  = 0;
+    mNumEPAIterations  = 0;
+    mNumSupportQueries = 0;
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_GJK_EPA_HPP_*/
@@ -17,8 +17,32 @@
  *
  * @brief runtime logging utility
  *
+ *        The level is set at runtime by setLogLevel(), and the levels above
+ *        MAKENA_MAX_LOG_LEVEL are removed at compile time.
+ *        MAKENA_LOG() evaluates the arguments only if the level is enabled.
+ *
  * @reference
  */
+
+/** @brief the highest LogLevel compiled in. Define it as 0 (OFF) on the
+ *         command line to remove all the logging from the hot paths.
+ */
+#ifndef MAKENA_MAX_LOG_LEVEL
+#define MAKENA_MAX_LOG_LEVEL 4
+#endif
+
+/** @brief calls log() from a member function of a Loggable with __FILE__
+ *         and __LINE__. The arguments are not evaluated if the level is
+ *         disabled, and the call is removed at compile time if the level
+ *         is above MAKENA_MAX_LOG_LEVEL.
+ */
+#define MAKENA_LOG(lvl, ...)                                    \
+    do {                                                        \
+        if (isLogEnabled(lvl)) {                                \
+            log(lvl, __FILE__, __LINE__, __VA_ARGS__);          \
+        }                                                       \
+    } while (false)
+
 namespace Makena {
 
 class Loggable {
@@ -42,15 +66,33 @@ class Loggable {
      */
     inline void setLogLevel(enum LogLevel lvl);
 
+    /** @brief tests if the messages of the given level are emitted.
+     *         It is false at compile time above MAKENA_MAX_LOG_LEVEL.
+     */
+    inline bool isLogEnabled(enum LogLevel lvl) const;
+
+    /** @brief emits the message in the printf format if the level is
+     *         enabled. The check is inlined, and the message is formatted
+     *         by logFormatted() only if enabled.
+     */
+    template<class... Args>
     inline void log(
         enum LogLevel lvl,
-        const char*   _file, 
+        const char*   _file,
         const int     _line,
-        const char*   fmt...
+        const char*   fmt,
+        Args...       args
     ) const;
 
   protected:
 
+    inline void logFormatted(
+        enum LogLevel lvl,
+        const char*   _file, 
+        const int     _line,
+        const char*   fmt...
+    ) const;
+
     /** @brief logging output */
     std::ostream&                          mLogStream;
 
@@ -69,45 +111,62 @@ void Loggable::setLogLevel(enum LogLevel lvl)
 }
 
 
+bool Loggable::isLogEnabled(enum LogLevel lvl) const
+{
+    return lvl <= MAKENA_MAX_LOG_LEVEL && mLogLevel>0 && mLogLevel>=lvl;
+}
+
+
+template<class... Args>
 void Loggable::log(
     enum LogLevel lvl,
     const char*   _file,
     const int     _line,
-    const char*   fmt...
+    const char*   fmt,
+    Args...       args
 ) const {
 
-    if (mLogLevel>0 && mLogLevel>=lvl) {
+    if (isLogEnabled(lvl)) {
+        logFormatted(lvl, _file, _line, fmt, args...);
+    }
+}
 
-        char buffer[1024];
 
-        switch (lvl) {
+void Loggable::logFormatted(
+    enum LogLevel lvl,
+    const char*   _file,
+    const int     _line,
+    const char*   fmt...
+) const {
 
-          case ERROR:
-            mLogStream << "ERROR: ";
-            break;
+    char buffer[1024];
 
-          case WARNING:
-            mLogStream << "WARNING: ";
-            break;
+    switch (lvl) {
 
-          case INFO:
-            mLogStream << "INFO: ";
-            break;
+      case ERROR:
+        mLogStream << "ERROR: ";
+        break;
 
-          default:
-            mLogStream << "<unknown>: ";
-            break;
+      case WARNING:
+        mLogStream << "WARNING: ";
+        break;
 
-        }
+      case INFO:
+        mLogStream << "INFO: ";
+        break;
 
-        mLogStream << _file << ":[" << _line << "] ";
-        va_list args;
-        va_start(args, fmt);
-        vsnprintf(buffer, 1024, fmt, args);
-        va_end(args);
-        mLogStream << buffer << "\n";
+      default:
+        mLogStream << "<unknown>: ";
+        break;
 
     }
+
+    mLogStream << _file << ":[" << _line << "] ";
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, 1024, fmt, args);
+    va_end(args);
+    mLogStream << buffer << "\n";
 }
    
 }// namespace Makena
@@ -84,27 +84,67 @@ list<HalfEdgeIt> Face::halfEdgesFromEdges(const list<EdgeIt>& edges)
 }
 
 
+void Face::halfEdgesFromEdges(
+    const EdgeIt* edges,
+    const size_t  numEdges,
+    HalfEdgeIt*   halfEdges
+) {
+    // Find the initial vertex.
+    auto he11Src = (*((*edges[0])->mHe1))->mSrc;
+    auto he12Src = (*((*edges[0])->mHe2))->mSrc;
+    auto he21Src = (*((*edges[1])->mHe1))->mSrc;
+    auto he22Src = (*((*edges[1])->mHe2))->mSrc;
+
+    VertexIt vSrc;
+    if (he11Src == he21Src || he11Src == he22Src) {
+        vSrc = he12Src;
+    }
+    else {
+        vSrc = he11Src;
+    }
+
+    for (size_t i = 0; i < numEdges; i++) {
+        auto& eit = edges[i];
+        auto he = ((*((*eit)->mHe1))->mSrc==vSrc)?(*eit)->mHe1:(*eit)->mHe2;
+        halfEdges[i] = he;
+        vSrc = (*he)->mDst;
+    }
+}
+
+
 FaceIt Manifold::makePolygon (const list<HalfEdgeIt>& halfEdges) {
 
-    auto fp = make_unique<Face>();
+    mWorkPolygonHalfEdges.assign(halfEdges.begin(), halfEdges.end());
+    return makePolygon(
+                  mWorkPolygonHalfEdges.data(), mWorkPolygonHalfEdges.size());
+}
+
+
+FaceIt Manifold::makePolygon (
+    const HalfEdgeIt* halfEdges,
+    const size_t      numHalfEdges
+) {
+    auto fp = makeFeature<Face>();
     fp->setId(mNextIdForFeatures++);
     auto fit = mFaces.insert(mFaces.end(), std::move(fp));
 //    (*fit)->mId     = mNumFaces++;
     (*fit)->mBackIt = fit;
 
-    if (halfEdges.size() < 2) {
+    if (numHalfEdges < 2) {
 
         return fit;
     }
 
-    for (auto& heit : halfEdges) {
+    for (size_t i = 0; i < numHalfEdges; i++) {
+        auto& heit = halfEdges[i];
         (*heit)->mFaceBackIt = (*fit)->mIncidentHalfEdges.insert(
                                       (*fit)->mIncidentHalfEdges.end(), heit);
     }    
 
     HalfEdgeIt hitPrev;
     size_t edgeIndex = 0;
-    vector<Vec3> points;
+    auto& points = mWorkPolygonPoints;
+    points.clear();
     for (auto& hit : (*fit)->mIncidentHalfEdges) {
         points.push_back((*((*hit)->mSrc))->pLCS());
         (*hit)->mFace = fit;
@@ -219,6 +259,7 @@ FaceIt Manifold::makePolygon (const list<HalfEdgeIt>& halfEdges) {
             if (pred!=NONE) {
                 (*fit)->mPred = MAYBE_FLAT;
             }
+            return fit;
         }
 
         long ind1 = std::min(xMinIndex, std::min(xMaxIndex, yAbsMaxIndex));
@@ -265,6 +306,17 @@ vector<HalfEdgeIt> Manifold::findCircumference(
     bool&           abort
 ) {
     vector<HalfEdgeIt> boundaryHalfEdges;
+    findCircumference(faces, boundaryHalfEdges, abort);
+    return boundaryHalfEdges;
+}
+
+
+void Manifold::findCircumference(
+    vector<FaceIt>&     faces,
+    vector<HalfEdgeIt>& boundaryHalfEdges,
+    bool&               abort
+) {
+    boundaryHalfEdges.clear();
 
     for (auto& fit : faces) {
         for (auto& heit : (*fit)->mIncidentHalfEdges) {
@@ -292,7 +344,7 @@ vector<HalfEdgeIt> Manifold::findCircumference(
                 (*heit)->mToBeMerged = false;
             }
         }
-        return boundaryHalfEdges;
+        return;
     }
 
     boundaryHalfEdges.push_back(heStart);
@@ -316,14 +368,13 @@ vector<HalfEdgeIt> Manifold::findCircumference(
     else {
         abort = false;
     }
-    return boundaryHalfEdges;
-
 }
 
 
 void Manifold::removeFaces(vector<FaceIt>& faces)
 {
-    vector<EdgeIt> edgesToBeRemoved;
+    auto& edgesToBeRemoved = mWorkEdges;
+    edgesToBeRemoved.clear();
 
     for (auto& fit : faces) {
 
@@ -646,7 +697,8 @@ VertexIt Manifold::makeCircularFan(
 
             auto fBuddy = (*((*hBase1)->mBuddy))->mFace;
 
-            (*((*hBase1)->mParent))->mPredFaces = (*fit)->isCoplanar(fBuddy);
+            (*((*hBase1)->mParent))->mPredFaces =
+                                                facesCoplanarity(fit, fBuddy);
 
             //if (i>1) {
             //
@@ -664,11 +716,13 @@ VertexIt Manifold::makeCircularFan(
 
             auto fBuddy = (*((*hBase2)->mBuddy))->mFace;
 
-            (*((*hBase2)->mParent))->mPredFaces = (*fit)->isCoplanar(fBuddy);
+            (*((*hBase2)->mParent))->mPredFaces =
+                                                facesCoplanarity(fit, fBuddy);
 
             fBuddy = (*((*hLast)->mBuddy))->mFace;
 
-            (*((*hLast)->mParent))->mPredFaces = (*fit)->isCoplanar(fBuddy);
+            (*((*hLast)->mParent))->mPredFaces =
+                                                facesCoplanarity(fit, fBuddy);
 
             //fBuddy = (*((*hStem2)->mBuddy))->mFace;
 
@@ -759,7 +813,7 @@ void Manifold::importData(Martialled& M) {
         const auto  id = pit->first;
         const auto& p  = pit->second;
 
-        auto vp = make_unique<Vertex>(p);
+        auto vp = makeFeature<Vertex>(p);
         auto vit = mVertices.insert(mVertices.end(), std::move(vp));
         (*vit)->setId(id);
         (*vit)->mBackIt    = vit;
@@ -778,15 +832,15 @@ void Manifold::importData(Martialled& M) {
         auto& v2 = vertices[enit->first.second];
         auto& n  = enit->second;
 
-        auto ep = make_unique<Edge>();
+        auto ep = makeFeature<Edge>();
         auto eit = mEdges.insert(mEdges.end(), std::move(ep));
         (*eit)->mBackIt = eit;
         edges[enit->first] = eit;
-        auto hep1 = make_unique<HalfEdge>();
+        auto hep1 = makeFeature<HalfEdge>();
         hep1->setVerticesAndEdge(v1, v2, eit);
         auto heit1 = mHalfEdges.insert(mHalfEdges.end(), std::move(hep1));
 
-        auto hep2 = make_unique<HalfEdge>();
+        auto hep2 = makeFeature<HalfEdge>();
         hep2->setVerticesAndEdge(v2, v1, eit);
         auto heit2 = mHalfEdges.insert(mHalfEdges.end(), std::move(hep2));
 
@@ -1103,19 +1157,16 @@ void Manifold::emitText(Martialled& M, std::ostream& os)
 
 void Manifold::constructHelperMaps()
 {
-    mVertexIdToVertex.clear();
+    long maxVertexId = -1;
+    for (auto& v : mVertices) {
+        maxVertexId = max(maxVertexId, v->id());
+    }
+    mVertexIdToVertex.reset(mVertices.size(), maxVertexId);
     for (auto vit = mVertices.begin(); vit != mVertices.end(); vit++) {
-        (*vit)->mFaceCounts.clear();
-        for (auto heit : (*vit)->mIncidentHalfEdges) {
-            if ((*heit)->dst()==vit) {
-                (*vit)->mFaceCounts[(*(*heit)->face())->id()] = 1;
-            }
-        }
-        mVertexIdToVertex[(*vit)->id()] = vit;
+        mVertexIdToVertex.insert((*vit)->id(), vit);
     }
 
-    mEdgeIdToEdge.clear();
-    mVertexPairToEdge.clear();
+    mVertexPairToEdge.reset(mEdges.size());
     for (auto eit = mEdges.begin(); eit != mEdges.end(); eit++) {
         auto heit = (*eit)->he1();
         long id1 = (*(*heit)->src())->id();
@@ -1123,14 +1174,16 @@ void Manifold::constructHelperMaps()
         if (id1 > id2){
             swap(id1,id2);
         }
-        auto p = make_pair(id1, id2);
-        mEdgeIdToEdge[p] = eit;
-        mVertexPairToEdge[p]=eit;
+        mVertexPairToEdge.insert(make_pair(id1, id2), eit);
     }
 
-    mFaceIdToFace.clear();
+    long maxFaceId = -1;
+    for (auto& f : mFaces) {
+        maxFaceId = max(maxFaceId, f->id());
+    }
+    mFaceIdToFace.reset(mFaces.size(), maxFaceId);
     for (auto fit = mFaces.begin(); fit != mFaces.end(); fit++) {
-        mFaceIdToFace[(*fit)->id()]=fit;
+        mFaceIdToFace.insert((*fit)->id(), fit);
     }
 
 }
@@ -1142,48 +1195,40 @@ FaceIt Manifold::findFace(
     VertexIt& v3,
     bool&     found
 ) {
-    auto size1 = (*v1)->mFaceCounts.size();
-    auto size2 = (*v2)->mFaceCounts.size();
-    auto size3 = (*v3)->mFaceCounts.size();
-
-
-    if (size1 > size2 && size1 > size3) {
-        return findFaceOrdered(v1, v2, v3, found);
-    }
-    if (size2 > size1 && size2 > size3) {
-        return findFaceOrdered(v2, v3, v1, found);
-    }
-    else {
-        return findFaceOrdered(v3, v1, v2, found);
-    }
-}
-
-
-FaceIt Manifold::findFaceOrdered(
-    VertexIt& v1,
-    VertexIt& v2,
-    VertexIt& v3,
-    bool&     found
-) {
-    for (auto& pair : (*v1)->mFaceCounts) {
-        pair.second = 1;
-    }
-    for (auto& pair : (*v2)->mFaceCounts) {
-        auto it = (*v1)->mFaceCounts.find(pair.first);
-        if (it != (*v1)->mFaceCounts.end()) {
-            it->second++;
+    // Usually two of the vertices span an edge of the face, and the face
+    // is one of the two incident to the edge.
+    const array<VertexIt, 3> vits = {v1, v2, v3};
+    for (long i = 0; i < 3; i++) {
+        long id1 = (*vits[i])->id();
+        long id2 = (*vits[(i + 1) % 3])->id();
+        if (id1 > id2){
+            swap(id1,id2);
         }
-    }
-    for (auto& pair : (*v3)->mFaceCounts) {
-        auto it = (*v1)->mFaceCounts.find(pair.first);
-        if (it != (*v1)->mFaceCounts.end()) {
-            if (it->second==2) {
+        auto ep = mVertexPairToEdge.find(make_pair(id1, id2));
+        if (ep == nullptr) {
+            continue;
+        }
+        for (auto heit : {(*(*ep))->he1(), (*(*ep))->he2()}) {
+            auto fit = (*heit)->face();
+            if (fit != mFaces.end() && (*fit)->isIncident(vits[(i + 2) % 3])){
                 found = true;
-                return mFaceIdToFace[it->first];
+                return fit;
             }
         }
     }
 
+    // Otherwise, check the faces around v1.
+    for (auto heit : (*v1)->mIncidentHalfEdges) {
+        if ((*heit)->dst() != v1) {
+            continue;
+        }
+        auto fit = (*heit)->face();
+        if ((*fit)->isIncident(v2) && (*fit)->isIncident(v3)) {
+            found = true;
+            return fit;
+        }
+    }
+
     found = false;
     return mFaces.end();
 }
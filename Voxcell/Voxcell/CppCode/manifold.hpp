@@ -19,6 +19,8 @@
 #include "primitives.hpp"
 #include "quaternion.hpp"
 #include "loggable.hpp"
+#include "feature_pool.hpp"
+#include "feature_index.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -157,10 +159,21 @@ class Manifold;
  *         reference. Some experiments on clang-802.0.42 on MacBook Pro shows
  *         using iterators is as fast as using raw pointers in general.
  */
-using VertexIt   = list<unique_ptr<Vertex  > >::iterator;
-using HalfEdgeIt = list<unique_ptr<HalfEdge> >::iterator;
-using EdgeIt     = list<unique_ptr<Edge    > >::iterator;
-using FaceIt     = list<unique_ptr<Face    > >::iterator;
+using VertexIt   = FeatureList<Vertex  >::iterator;
+using HalfEdgeIt = FeatureList<HalfEdge>::iterator;
+using EdgeIt     = FeatureList<Edge    >::iterator;
+using FaceIt     = FeatureList<Face    >::iterator;
+
+/** @brief list of incident half edges of a vertex or a face. Its nodes
+ *         are taken from the feature pool of the manifold if enabled.
+ */
+using HalfEdgeItList = list<HalfEdgeIt, FeatureAllocator<HalfEdgeIt> >;
+
+/** @brief chains of the vertices and the edges to be removed in the
+ *         convex hull finding. Their nodes are taken from the pool as well.
+ */
+using VertexItList   = list<VertexIt,   FeatureAllocator<VertexIt  > >;
+using EdgeItList     = list<EdgeIt,     FeatureAllocator<EdgeIt    > >;
 using ManifoldIt = list<unique_ptr<Manifold> >::iterator;
 
 
@@ -177,7 +190,7 @@ class Vertex {
     inline Vec3  nGCS(const Mat3x3&rot) const;
 
     inline virtual ~Vertex();
-    inline const list<HalfEdgeIt>& halfEdges();
+    inline const HalfEdgeItList& halfEdges();
 
     inline void resetGen();
     inline void updateGen(unsigned long newGen);
@@ -225,7 +238,7 @@ class Vertex {
     /** @brief incident half edges in the counter-clockwise ordering
      *         facing the vertex from outside
      */
-    list<HalfEdgeIt>              mIncidentHalfEdges;
+    HalfEdgeItList                mIncidentHalfEdges;
 
     /** @brief iterator version of 'this'. */
     VertexIt                      mBackIt;
@@ -237,18 +250,13 @@ class Vertex {
 
     unsigned long                 mGeneration;
 
-    /** @brief a map from face to a count. Used to find a face from
-     *         three vertices.
-     */
-    map<long,long>                mFaceCounts;
-
     /** @brief mark to indicate this vertex's degree is 2 and hence
      *         must be removed.
      */
     bool                          mToBeRemoved;
 
     /** @brief back pointer to Manifold::mVerticesToBeRemoved */
-    list<VertexIt>::iterator      mBackItVTBR;
+    VertexItList::iterator        mBackItVTBR;
 
 
     /** @brief temporary dot product value stored for IntersectionFinder
@@ -269,8 +277,6 @@ class Vertex {
     long                          mIFcomponentIdaux;
 
   friend class Manifold;
-  friend std::unique_ptr<Vertex>
-         std::make_unique<Vertex, const Vec3&>(const Vec3&);
   friend std::ostream& operator<<(std::ostream& os, const Vertex& V);
   friend class IntersectionDecomposer;
 
@@ -343,19 +349,19 @@ class HalfEdge {
     VertexIt                              mSrc;
 
     /** @brief iterator into the source vertex's edge list */
-    list<HalfEdgeIt>::const_iterator      mSrcBackIt;
+    HalfEdgeItList::const_iterator        mSrcBackIt;
 
     /** @brief destination vertex */
     VertexIt                              mDst;
 
     /** @brief iterator into the destination vertex's edge list */
-    list<HalfEdgeIt>::const_iterator      mDstBackIt;
+    HalfEdgeItList::const_iterator        mDstBackIt;
 
     /** @brief incident face */
     FaceIt                                mFace;
 
     /** @brief iterator into the incident face's half edge list */
-    list<HalfEdgeIt>::const_iterator      mFaceBackIt;
+    HalfEdgeItList::const_iterator        mFaceBackIt;
 
     /** @brief Edge that owns this half edge */
     EdgeIt                                mParent;
@@ -379,7 +385,6 @@ class HalfEdge {
   friend class Edge;
   friend class Face;
   friend class Manifold;
-  friend std::unique_ptr<HalfEdge> std::make_unique<HalfEdge>();
 
 };
 
@@ -453,7 +458,7 @@ class Edge {
     /** @brief back pointer into Manifold::mEdgesToBeRemoved where
      *         the edges to be removed are chained.
      */
-    list<EdgeIt>::iterator mBackItETBR;
+    EdgeItList::iterator   mBackItETBR;
 
     /** @brief temporary data storage used by IntersectionFinder
      */
@@ -473,7 +478,6 @@ class Edge {
   friend class Face;
   friend class Manifold;
   friend class IntersectionFinder;
-  friend std::unique_ptr<Edge> std::make_unique<Edge>();
   friend class IntersectionDecomposer;
 
 };
@@ -513,6 +517,21 @@ class Face {
     static list<HalfEdgeIt> halfEdgesFromEdges(const list<EdgeIt>& edges);
 
 
+    /** @brief the same as above for an array of two or more edges.
+     *
+     *  @param edges     (in):  circular array of edges
+     *
+     *  @param numEdges  (in):  number of the edges
+     *
+     *  @param halfEdges (out): circular array of half edges of numEdges
+     */
+    static void halfEdgesFromEdges(
+        const EdgeIt* edges,
+        const size_t  numEdges,
+        HalfEdgeIt*   halfEdges
+    );
+
+
     /** @brief check the state of this face relative to
      *         one of the indicent faces.
      *
@@ -553,7 +572,7 @@ class Face {
 
     inline Vec3  nGCS(const Mat3x3&rot) const;
 
-    inline list<HalfEdgeIt>& halfEdges();
+    inline HalfEdgeItList& halfEdges();
 
     inline long textureID() const;
 
@@ -576,7 +595,7 @@ class Face {
     Vec3             mNormalLCS;
 
     /** @brief hald edge chain along the face in counter-clockwise ordering */
-    list<HalfEdgeIt> mIncidentHalfEdges;
+    HalfEdgeItList   mIncidentHalfEdges;
 
     /** @brief prdicate of the shape of this face */
     enum predicate   mPred;
@@ -587,6 +606,9 @@ class Face {
     /** @brief used in the conflict graph in findConvexHull() */
     Undirected::node_list_it_t   mFaceConflict;
 
+    /** @brief index into ConflictLists used in findConvexHull() */
+    long                         mConflictIndex;
+
     /** @brief texture ID for this face. */
     long             mTextureID;
 
@@ -609,23 +631,476 @@ class Face {
 
 
   friend class Manifold;
-  friend std::unique_ptr<Face> std::make_unique<Face>();
   friend class IntersectionDecomposer;
 
 };
 
 
-class FrontierElem;
 class FaceConflict;
 class VertexConflict;
 
+
+/* @class FrontierElem
+ *
+ * @brief temporarily holds the visible vertices to the two faces adjacent 
+ *        to the edge specified by the half edge.
+ *        This is used to transfer the visible vertices from the old face
+ *        to the new one around the frontier.
+ */
+class FrontierElem {
+  public:
+
+    /** @brief the half edge */
+    HalfEdgeIt                         mHeit;
+
+    /** @brief the set of visible vertices to the faces incident to
+     *         the half edge.
+     */
+    vector<Undirected::node_list_it_t> mFacingVertices;
+
+    /** @brief the same as above in CONFLICT_LISTS mode as the range
+     *         [mFacingPointsBegin, mFacingPointsEnd) in
+     *         Manifold::mWorkFrontierPoints of the indices into
+     *         Manifold::mConflictLists.
+     */
+    long                               mFacingPointsBegin;
+    long                               mFacingPointsEnd;
+
+};
+
+
+/** @class ConflictLists
+ *
+ *  @brief flat-array representation of the bi-partite conflict graph used
+ *         in findConvexHull(). The points are stored contiguously and
+ *         addressed by their index. Each face has a contiguous array of
+ *         the indices of the points outside of it, and each point has
+ *         a contiguous array of the indices of the faces it can see.
+ *
+ *         Faces and points are removed lazily. A removed face is only
+ *         marked, and it is skipped and compacted away the next time the
+ *         face array of a point is scanned. A removed point is skipped
+ *         when the point array of a face is scanned.
+ *         The relative ordering of the live elements in each array is
+ *         the same as the ordering of the incident edges in the conflict
+ *         graph, and hence both produce the identical hull.
+ */
+class ConflictLists {
+
+  public:
+
+    inline ConflictLists();
+
+    /** @brief removes all the points and faces. The capacities of the
+     *         arrays are kept for reuse.
+     */
+    inline void clear();
+
+    /** @brief removes all the points and faces, and frees the memory. */
+    inline void release();
+
+    /** @brief removes all the points and empties the point arrays of
+     *         the faces. The faces are kept.
+     */
+    inline void clearPoints();
+
+    /** @brief adds a point and returns its index. */
+    inline long addPoint(const Vec3& p, const long id);
+
+    /** @brief adds a face and returns its index. */
+    inline long addFace(const FaceIt& fit);
+
+    /** @brief adds a conflict between the point and the face. */
+    inline void addConflict(const long faceIndex, const long pointIndex);
+
+    /** @brief marks the face removed and recycles its point array. */
+    inline void removeFace(const long faceIndex);
+
+    /** @brief marks the point removed and recycles its face array. */
+    inline void removePoint(const long pointIndex);
+
+    /** @brief removes the stale entries from the face array of the point
+     *         and returns it.
+     */
+    inline const vector<long>& faces(const long pointIndex);
+
+    /** @brief points outside of the face. It may contain removed points.*/
+    inline const vector<long>& points(const long faceIndex) const;
+
+    inline const Vec3& p (const long pointIndex) const;
+    inline long        id(const long pointIndex) const;
+    inline FaceIt      face(const long faceIndex) const;
+    inline bool        isPointRemoved(const long pointIndex) const;
+    inline long        numPoints() const;
+    inline long        numFaces() const;
+    inline long        numFacesRemoved() const;
+
+    /** @brief temporary flag used to avoid doubly adding the same point
+     *         to the list when two or more faces are merged.
+     */
+    vector<unsigned char>  mPointFound;
+
+  private:
+
+    /** @brief returns an empty array for a new point or face. */
+    inline vector<long> takeSpareArray();
+
+    /** @brief empties the array and keeps it for takeSpareArray(). */
+    inline void recycleArray(vector<long>& a);
+
+    vector<Vec3>           mPoints;
+    vector<long>           mIds;
+    vector<vector<long> >  mPointFaces;
+    vector<unsigned char>  mPointRemoved;
+
+    vector<FaceIt>         mFaces;
+    vector<vector<long> >  mFacePoints;
+    vector<unsigned char>  mFaceRemoved;
+    long                   mNumFacesRemoved;
+
+    /** @brief emptied arrays of the removed points and faces. They keep
+     *         their capacities to avoid the reallocations.
+     */
+    vector<vector<long> >  mSpareArrays;
+};
+
+
+/** @class HullStats
+ *
+ *  @brief statistics of the last call to findConvexHull() or addPoints().
+ *         The counters are always updated. The wall times of the phases
+ *         are measured only if enabled by Manifold::setHullStatsEnabled().
+ *         The phases do not overlap, and the rest of the total time is
+ *         spent on the setup and the tidy-up.
+ */
+class HullStats {
+
+  public:
+
+    enum Phase {
+        PHASE_ANALYZE_POINTS,
+        PHASE_INITIAL_CONFLICTS,
+        PHASE_VISIBLE_FACES,
+        PHASE_FAN_CREATION,
+        PHASE_CONFLICT_UPDATE,
+        PHASE_FACE_MERGES,
+        NUM_PHASES
+    };
+
+    inline HullStats();
+
+    /** @brief resets all the counters and the times to zero. */
+    inline void clear();
+
+    /** @brief returns the name of the phase for logging. */
+    inline static const char* phaseName(enum Phase phase);
+
+    /** @brief wall time of each phase in seconds. */
+    double mPhaseSeconds[NUM_PHASES];
+
+    /** @brief wall time of the whole call in seconds. */
+    double mTotalSeconds;
+
+    /** @brief number of conflicts between the points and the faces
+     *         created.
+     */
+    long   mNumConflictsCreated;
+
+    /** @brief number of points whose insertion was aborted, as they are
+     *         too close to a face or the visible region is not a disc.
+     */
+    long   mNumInsertionAborts;
+
+    /** @brief number of edge removals aborted in the face merges. */
+    long   mNumMergeAborts;
+
+    /** @brief number of merges of adjacent faces. */
+    long   mNumFaceMerges;
+
+    /** @brief number of vertices of degree 2 removed. */
+    long   mNumVerticesRemoved;
+};
+
+
+/** @class SupportStats
+ *
+ *  @brief counters of the support vertex queries on a manifold.
+ *         They accumulate over the queries until cleared by
+ *         Manifold::clearSupportStats().
+ */
+class SupportStats {
+
+  public:
+
+    inline SupportStats();
+
+    /** @brief resets all the counters to zero. */
+    inline void clear();
+
+    /** @brief number of the queries answered. */
+    long   mNumQueries;
+
+    /** @brief number of the moves to a farther adjacent vertex. */
+    long   mNumSteps;
+
+    /** @brief number of the vertices whose heights are evaluated. */
+    long   mNumVerticesTested;
+};
+
+
 class Manifold : public Loggable {
 
   public:
 
+    /** @brief specifies how the conflicts between the points and the faces
+     *         are tracked in findConvexHull().
+     *
+     *         CONFLICT_LISTS : contiguous per-face and per-point arrays
+     *                          (ConflictLists). Default.
+     *
+     *         CONFLICT_GRAPH : bi-partite DiGraph (mConflictGraph).
+     *                          Kept as the reference implementation.
+     */
+    enum ConflictTrackingMode {
+        CONFLICT_LISTS,
+        CONFLICT_GRAPH
+    };
+
+    /** @brief specifies the order in which the points are inserted
+     *         into the hull in findConvexHull().
+     *
+     *         INSERTION_ORDER_SHUFFLED : random permutation generated from
+     *                                    the seed. Default. The expected
+     *                                    running time O(n*log(n)) holds
+     *                                    only for this order.
+     *
+     *         INSERTION_ORDER_INPUT    : the order given in the input.
+     */
+    enum InsertionOrder {
+        INSERTION_ORDER_SHUFFLED,
+        INSERTION_ORDER_INPUT
+    };
+
+    /** @brief default seed for INSERTION_ORDER_SHUFFLED. */
+    static constexpr unsigned long DEFAULT_INSERTION_SEED = 5489UL;
+
+    /** @brief specifies the Akl-Toussaint pre-pass of findConvexHull()
+     *         that discards the points strictly inside a polytope
+     *         spanned by some extremal points.
+     *
+     *         INTERIOR_CULLING_NONE       : no culling.
+     *
+     *         INTERIOR_CULLING_OCTAHEDRON : the extremal points along
+     *                                       +-x, +-y, and +-z.
+     *
+     *         INTERIOR_CULLING_14DOP      : the above plus the extremal
+     *                                       points along the 8 diagonals
+     *                                       (+-1, +-1, +-1). Default.
+     *
+     *         The 4 points of the initial 3-simplex found in
+     *         analyzePoints() are always added to the polytope.
+     */
+    enum InteriorCulling {
+        INTERIOR_CULLING_NONE,
+        INTERIOR_CULLING_OCTAHEDRON,
+        INTERIOR_CULLING_14DOP
+    };
+
+    /** @brief specifies the approximation of the hull in findConvexHull()
+     *         under the budget given by setHullBudget().
+     *
+     *         HULL_APPROXIMATION_NONE     : the exact hull. Default.
+     *
+     *         HULL_APPROXIMATION_INNER    : the points are inserted in the
+     *                                       farthest-outside-first order
+     *                                       until the budget is reached.
+     *                                       The hull is inside the exact
+     *                                       one by approximationError().
+     *
+     *         HULL_APPROXIMATION_EXPANDED : the same as above, and then
+     *                                       the hull is scaled about the
+     *                                       centroid of its vertices until
+     *                                       it encloses all the points
+     *                                       within the numerical margin.
+     */
+    enum HullApproximation {
+        HULL_APPROXIMATION_NONE,
+        HULL_APPROXIMATION_INNER,
+        HULL_APPROXIMATION_EXPANDED
+    };
+
+    /** @brief specifies the geometric predicates used in findConvexHull().
+     *
+     *         PREDICATES_EPSILON        : the signed distances and the
+     *                                     angles are compared against
+     *                                     the margin given to
+     *                                     findConvexHull(). The faces
+     *                                     coplanar within the margin are
+     *                                     merged, and the points too close
+     *                                     to a face are discarded. Default.
+     *
+     *         PREDICATES_FILTERED_EXACT : the orientation of a point against
+     *                                     the plane of a face is decided
+     *                                     by orient3d(), whose double
+     *                                     evaluation falls back to the
+     *                                     exact one only if the result is
+     *                                     within its error bound. Only the
+     *                                     exactly coplanar faces are
+     *                                     merged, and no point is
+     *                                     discarded as too close to a face.
+     *                                     The faces stay exactly planar.
+     *
+     *         PREDICATES_EXACT_INTEGER  : same as PREDICATES_FILTERED_EXACT
+     *                                     but orient3dInteger() is used.
+     *                                     All the points must have integer
+     *                                     coordinates less than
+     *                                     ORIENT3D_INTEGER_LIMIT in
+     *                                     magnitude.
+     */
+    enum PredicateMode {
+        PREDICATES_EPSILON,
+        PREDICATES_FILTERED_EXACT,
+        PREDICATES_EXACT_INTEGER
+    };
+
+    /** @brief allocation of the features and the nodes of their lists.
+     *
+     *         FEATURE_ALLOCATION_HEAP : each feature and each list node is
+     *                                   allocated separately on the heap.
+     *
+     *         FEATURE_ALLOCATION_POOL : they are taken from FeaturePool
+     *                                   owned by this manifold. The freed
+     *                                   ones are recycled, and the memory
+     *                                   is released at once by clear().
+     */
+    enum FeatureAllocation {
+        FEATURE_ALLOCATION_HEAP,
+        FEATURE_ALLOCATION_POOL
+    };
+
+    /** @brief what clear() does with the memory used by findConvexHull()
+     *         and addPoints().
+     *
+     *         WORKSPACE_RELEASE : the feature pool, the conflict lists
+     *                             and the work arrays are freed by clear().
+     *                             Default.
+     *
+     *         WORKSPACE_RETAIN  : they are emptied but keep their
+     *                             capacities, so that the repeated calls
+     *                             of clear() and findConvexHull() on the
+     *                             same manifold settle to almost no heap
+     *                             allocations. The memory is kept up to
+     *                             the largest hull made so far.
+     */
+    enum WorkspaceMode {
+        WORKSPACE_RELEASE,
+        WORKSPACE_RETAIN
+    };
+
     inline Manifold(std::ostream& logStream = std::cerr);
     inline virtual ~Manifold();
 
+    /** @brief the features refer to the pool and to each other by
+     *         iterators, and hence the manifold can be neither copied
+     *         nor moved.
+     */
+    Manifold(const Manifold&) = delete;
+    Manifold& operator=(const Manifold&) = delete;
+    Manifold(Manifold&&) = delete;
+    Manifold& operator=(Manifold&&) = delete;
+
+    /** @brief sets the allocation of the features.
+     *         This manifold is cleared.
+     */
+    inline void setFeatureAllocation(enum FeatureAllocation allocation);
+
+    /** @brief returns the number of bytes taken by the feature pool. */
+    inline size_t featurePoolBytes() const;
+
+    /** @brief sets the workspace mode. Switching to WORKSPACE_RELEASE
+     *         frees the retained memory at the next clear().
+     */
+    inline void setWorkspaceMode(enum WorkspaceMode mode);
+
+    /** @brief sets the conflict tracking mode used in findConvexHull().
+     */
+    inline void setConflictTrackingMode(enum ConflictTrackingMode mode);
+
+    /** @brief sets the insertion order used in findConvexHull().
+     *
+     *  @param  order (in): the insertion order.
+     *
+     *  @param  seed  (in): the seed for INSERTION_ORDER_SHUFFLED.
+     *                      The same seed gives the same permutation
+     *                      on all the platforms.
+     */
+    inline void setInsertionOrder(
+        enum InsertionOrder order,
+        const unsigned long seed = DEFAULT_INSERTION_SEED
+    );
+
+    /** @brief sets the interior culling used in findConvexHull().
+     */
+    inline void setInteriorCulling(enum InteriorCulling culling);
+
+    /** @brief returns the number of points discarded by the interior
+     *         culling in the last call to findConvexHull().
+     */
+    inline long numPointsCulled() const;
+
+    /** @brief sets the geometric predicates used in findConvexHull() and
+     *         addPoints(). It must not be changed between the calls to
+     *         addPoints() for the same hull.
+     */
+    inline void setPredicateMode(enum PredicateMode mode);
+
+    /** @brief sets the approximation and the budget of the hull used in
+     *         findConvexHull(). The insertion stops before the number of
+     *         vertices exceeds maxVertices, once the number of faces
+     *         reaches maxFaces, or once the farthest point outside is
+     *         within tolerance of the hull. The faces created by the last
+     *         insertion can exceed maxFaces.
+     *         The budget is ignored by addPoints().
+     *
+     *  @param approx      (in): the approximation.
+     *
+     *  @param maxVertices (in): maximum number of vertices. 0 for no limit.
+     *
+     *  @param maxFaces    (in): maximum number of faces. 0 for no limit.
+     *
+     *  @param tolerance   (in): distance below which the remaining points
+     *                           are not inserted.
+     */
+    inline void setHullBudget(
+        enum HullApproximation approx,
+        const long             maxVertices,
+        const long             maxFaces  = 0,
+        const double           tolerance = 0.0
+    );
+
+    /** @brief returns the largest distance of the points outside of the
+     *         hull from the planes of the faces they see, measured before
+     *         the expansion, in the last call to findConvexHull().
+     *         0.0 for HULL_APPROXIMATION_NONE.
+     */
+    inline double approximationError() const;
+
+    /** @brief returns the factor by which HULL_APPROXIMATION_EXPANDED
+     *         scaled the hull in the last call to findConvexHull().
+     */
+    inline double approximationScale() const;
+
+    /** @brief enables the measurement of the wall times in HullStats.
+     *         The counters are kept regardless.
+     */
+    inline void setHullStatsEnabled(const bool enabled);
+
+    /** @brief returns the statistics of the last call to findConvexHull()
+     *         or addPoints(). For findConvexHullParallel(), it is for the
+     *         final hull of the vertices of the partitions.
+     */
+    inline const HullStats& hullStats() const;
+
     /** @brief reset this manifold to the initial empty state.
      */
     inline void clear();
@@ -733,6 +1208,197 @@ class Manifold : public Loggable {
         const double    epsilon = EPSILON_SQUARED
     );
 
+
+    /** @brief finds the convex hull of the cells on an integer grid such as
+     *         the ones from VolumeBitmap.findShell().
+     *         Only the cells at the ends of their rows, columns and slabs
+     *         along the 3 axes can be the vertices of the hull, and the
+     *         others are discarded beforehand. The hull is found in the grid
+     *         coordinates with PREDICATES_EXACT_INTEGER, or with
+     *         PREDICATES_FILTERED_EXACT if a coordinate is not less than
+     *         ORIENT3D_INTEGER_LIMIT in magnitude, and then the vertices
+     *         are mapped to origin + pitch * (x, y, z).
+     *         The predicate mode of this manifold is not changed.
+     *
+     *  @param cells  (in):  the integer coordinates of the cells.
+     *                       The IDs of the vertices are the indices into it.
+     *
+     *  @param origin (in):  the point for the cell (0, 0, 0).
+     *
+     *  @param pitch  (in):  the edge length of the cells.
+     *
+     *  @param pred   (out): predicate to specify any degeneracy found.
+     */
+    void findConvexHullOfGridCells(
+        const vector<array<long, 3>>& cells,
+        const Vec3&                   origin,
+        const double                  pitch,
+        enum predicate&               pred
+    );
+
+
+    /** @brief multi-threaded version of findConvexHull().
+     *         The points are partitioned into spatially separated groups by
+     *         the median splits along the longest axis, the hull of each
+     *         group is found concurrently in its own Manifold, and then
+     *         the hull of the union of their vertices is found in this
+     *         manifold by findConvexHull(). The settings of this manifold
+     *         (conflict tracking, insertion order, and interior culling)
+     *         are used for all the hulls.
+     *
+     *         The partitions save time only if they discard most of the
+     *         points. If more than MAX_HULL_RATIO_FOR_PARTITIONS of a
+     *         sample of MIN_POINTS_PER_PARTITION points are on its hull,
+     *         e.g. for the points on a sphere, the hull is found by
+     *         findConvexHull() without partitions.
+     *
+     *  @param points     (in):  the points.
+     *
+     *  @param indices    (in):  the IDs of the points.
+     *
+     *  @param pred       (out): predicate to specify any degeneracy found.
+     *
+     *  @param numThreads (in):  the number of threads. 0 means
+     *                           std::thread::hardware_concurrency().
+     *                           If the number of points is small, fewer
+     *                           threads are used.
+     *
+     *  @param epsilon    (in):  numerical margin used for predicates.
+     */
+    void findConvexHullParallel(
+        vector<Vec3>&   points,
+        vector<long>&   indices,
+        enum predicate& pred,
+        const long      numThreads = 0,
+        const double    epsilon    = EPSILON_SQUARED
+    );
+
+    void findConvexHullParallel(
+        vector<Vec3>&   points,
+        enum predicate& pred,
+        const long      numThreads = 0,
+        const double    epsilon    = EPSILON_SQUARED
+    );
+
+    /** @brief minimum number of points per partition in
+     *         findConvexHullParallel().
+     */
+    static constexpr long MIN_POINTS_PER_PARTITION = 4096;
+
+    /** @brief maximum ratio of the sample points on the hull for
+     *         findConvexHullParallel() to partition the points.
+     */
+    static constexpr double MAX_HULL_RATIO_FOR_PARTITIONS = 0.5;
+
+
+    /** @brief adds the given points to the convex hull in this manifold
+     *         incrementally. The faces of the hull stay registered in the
+     *         conflict lists between the calls, and only the points outside
+     *         of the current hull are inserted. The points inside are
+     *         discarded. Each new point is located by a walk over the
+     *         faces from the face found for the previous point instead of
+     *         testing all the faces. The cost is proportional to the
+     *         number of new points times the length of the walk, plus the
+     *         updates around the inserted points, plus O(V+E) per call to
+     *         set the normals and the helper maps again, and it does not
+     *         depend on the number of points given in the previous calls.
+     *         If the hull is too flat for the walk, the points are tested
+     *         against all the faces in O(points x faces).
+     *
+     *         If this manifold is empty, the points are kept until enough
+     *         of them are given to span a 3-simplex, and then the hull is
+     *         found by findConvexHull(). The hull can also be the one
+     *         found by findConvexHull() or any other convex manifold.
+     *         The settings of insertion order are applied to each batch.
+     *         The conflicts are always tracked with CONFLICT_LISTS.
+     *
+     *  @param points  (in):  the new points.
+     *
+     *  @param indices (in):  the IDs of the new points.
+     *
+     *  @param pred    (out): MAYBE_COLINEAR or MAYBE_COPLANAR if the points
+     *                        given so far do not span a 3-simplex yet.
+     *                        NONE otherwise.
+     *
+     *  @param epsilon (in):  numerical margin used for predicates.
+     */
+    void addPoints(
+        vector<Vec3>&   points,
+        vector<long>&   indices,
+        enum predicate& pred,
+        const double    epsilon = EPSILON_SQUARED
+    );
+
+    /** @brief the IDs are assigned consecutively from one past the
+     *         largest ID of the vertices of this manifold and of the
+     *         points given to addPoints() so far. They do not collide with
+     *         the vertices made by findConvexHull(), importData() or the
+     *         other constructions.
+     */
+    void addPoints(
+        vector<Vec3>&   points,
+        enum predicate& pred,
+        const double    epsilon = EPSILON_SQUARED
+    );
+
+    /** @brief returns the number of points kept by addPoints() until
+     *         the initial hull can be made.
+     */
+    inline long numPendingPoints() const;
+
+    /** @brief finds a vertex farthest along the direction, i.e., the
+     *         support mapping, by hill-climbing. From the start vertex,
+     *         it moves to the farthest adjacent vertex until no adjacent
+     *         vertex is farther. This manifold must be convex such as the
+     *         one made by findConvexHull(), where the local maximum is
+     *         the global one. It takes a few steps if the start vertex is
+     *         near the answer, e.g., the answer to the previous query of
+     *         a coherent sequence.
+     *
+     *  @param direction (in): the direction in LCS. It need not be
+     *                         normalized.
+     *
+     *  @param start     (in): the vertex to start from as a warm start.
+     *                         The first vertex is used if it is the end
+     *                         of the vertex list.
+     *
+     *  @return the vertex, or the end of the vertex list if empty.
+     */
+    VertexIt findSupportVertex(const Vec3& direction, VertexIt start);
+
+    /** @brief the same as above from the first vertex. */
+    VertexIt findSupportVertex(const Vec3& direction);
+
+    /** @brief answers the support vertex queries for many directions.
+     *         Each query starts from the answer to the previous one, and
+     *         hence it is faster if the consecutive directions are close.
+     *
+     *  @param directions (in):  the directions in LCS.
+     *
+     *  @param supports   (out): the vertices for the directions.
+     *                           The contents are replaced.
+     *
+     *  @param start      (in):  the vertex to start the first query from.
+     *                           The same as in findSupportVertex().
+     */
+    void findSupportVertices(
+        const vector<Vec3>& directions,
+        vector<VertexIt>&   supports,
+        VertexIt            start
+    );
+
+    /** @brief the same as above from the first vertex. */
+    void findSupportVertices(
+        const vector<Vec3>& directions,
+        vector<VertexIt>&   supports
+    );
+
+    /** @brief returns the counters of the support vertex queries. */
+    inline const SupportStats& supportStats() const;
+
+    /** @brief resets the counters of the support vertex queries. */
+    inline void clearSupportStats();
+
     inline EdgeIt findEdge(const VertexIt& vit1, const VertexIt& vit2);
 
     inline FaceIt findFace(const VertexIt& vit1, const VertexIt& vit2);
@@ -754,6 +1420,11 @@ class Manifold : public Loggable {
 
     inline pair<FaceIt,   FaceIt>   faces();
 
+    /** @brief finds the feature by the ID in O(1) with the tables made
+     *         at the end of the last construction such as findConvexHull().
+     *
+     *  @return the feature, or end() of the list if not found.
+     */
     inline VertexIt vertexIt(long id);
     inline EdgeIt   edgeIt  (const pair<long,long>& id);
     inline FaceIt   faceIt  (long id);
@@ -786,27 +1457,50 @@ class Manifold : public Loggable {
 
     static void emitText(Martialled& M, std::ostream& os);
 
-    void logContents(
+    /** @brief dumps the vertices and the faces if the level is enabled.
+     *         The level is checked inline, and the call is removed at
+     *         compile time above MAKENA_MAX_LOG_LEVEL.
+     */
+    inline void logContents(
         enum LogLevel lvl,
         const char*   _file,
         const int     _line
     );
 
-    void logConflictGraph(
+    /** @brief dumps the conflict graph or the conflict lists if the level
+     *         is enabled. Same as logContents() for the check.
+     */
+    inline void logConflictGraph(
         enum LogLevel lvl,
         const char*   _file,
         const int     _line
     );
 
-    void logVertexConflict(
+    /** @brief dumps the faces the point conflicts with if the level is
+     *         enabled. Same as logContents() for the check.
+     */
+    inline void logVertexConflict(
         enum LogLevel   lvl,
         const char*     _file,
         const int       _line,
         VertexConflict& VC
     );
 
+    inline void logVertexConflict(
+        enum LogLevel   lvl,
+        const char*     _file,
+        const int       _line,
+        const long      pointIndex
+    );
+
   private:
 
+    /** @brief bodies of the log functions above. */
+    void writeContents();
+    void writeConflictGraph();
+    void writeVertexConflict(VertexConflict& VC);
+    void writeVertexConflict(const long pointIndex);
+
     /** @brief convenience function to generate a face of polygon from its
      *         surrounding edges ordered counter-clockwise order.
      */
@@ -818,6 +1512,12 @@ class Manifold : public Loggable {
      */
     FaceIt makePolygon (const list<HalfEdgeIt>& halfEdges);
 
+    /** @brief the same as above from an array of half edges. */
+    FaceIt makePolygon (
+        const HalfEdgeIt* halfEdges,
+        const size_t      numHalfEdges
+    );
+
 
     /** @brief convenience function to generate a face of triangle from its
      *         surrounding edges ordered counter-clockwise order and the
@@ -862,6 +1562,15 @@ class Manifold : public Loggable {
      */
     vector<HalfEdgeIt> findCircumference(vector<FaceIt>& faces, bool& abort);
 
+    /** @brief the same as above into the given array, whose contents are
+     *         replaced.
+     */
+    void findCircumference(
+        vector<FaceIt>&     faces,
+        vector<HalfEdgeIt>& halfEdges,
+        bool&               abort
+    );
+
 
     /** @brief helper function to findCircumference() */
     HalfEdgeIt findNextBoundaryHalfEdge(HalfEdgeIt startIt);
@@ -927,6 +1636,26 @@ class Manifold : public Loggable {
      */
     inline VertexIt makeVertex(const Vec3& p, const long id = -1);
 
+    /** @brief allocates a feature by mFeatureAllocation.
+     *
+     *  @param  args (in): arguments to the constructor of T.
+     */
+    template<class T, class... Args>
+    inline FeaturePtr<T> makeFeature(Args&&... args);
+
+    /** @brief frees the work spaces and the conflict lists of the hull
+     *         finding.
+     */
+    inline void releaseWorkspace();
+
+    /** @brief lets the list of the incident half edges of the new feature
+     *         take its nodes from the pool. Nothing for Edge and HalfEdge.
+     */
+    inline void attachFeaturePool(Vertex& v);
+    inline void attachFeaturePool(Face& f);
+    template<class T>
+    inline void attachFeaturePool(T&){;}
+
 
     /** @brief creates and adds a new edge for the given incident vertices.
      *
@@ -951,7 +1680,9 @@ class Manifold : public Loggable {
 
     static std::vector<std::string> processLine(std::istream& is);
 
-    /** @brief constructs Vertex::mFaceCounts and Manifold::mVertexPairToEdge*/
+    /** @brief constructs mVertexIdToVertex, mVertexPairToEdge, and
+     *         mFaceIdToFace.
+     */
     void constructHelperMaps();
 
     /** @brief set the 2D texture coordinates for the faces.
@@ -962,14 +1693,12 @@ class Manifold : public Loggable {
      */
     void constructDefaultTextureCoordinates();
 
-    /** @brief find the face incident to the given three vertices */
+    /** @brief find the face incident to the given three vertices.
+     *         It uses mVertexPairToEdge.
+     */
     FaceIt findFace(VertexIt& v1, VertexIt& v2, VertexIt& v3, bool& found);
 
 
-    FaceIt findFaceOrdered(
-                    VertexIt& v1, VertexIt& v2, VertexIt& v3, bool& found);
-
-
 
     /** @brief subroutine for findConvexHull()
      *
@@ -1012,6 +1741,250 @@ class Manifold : public Loggable {
     );
 
 
+    /** @brief subroutine for findConvexHull()
+     *
+     *         CONFLICT_LISTS version of createInitialConflictGraph().
+     *         The conflicts are created into mConflictLists. Only the
+     *         points that see at least one face are added, in the given
+     *         order.
+     *
+     *  @param  points   (in):  the set of points in LCS.
+     *
+     *  @param  indices  (in):  the IDs of the points.
+     */
+    void createInitialConflictLists(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for findConvexHull() and addPoints()
+     *
+     *         classifies the given points against all the faces of the
+     *         manifold, which must be registered in mConflictLists, and
+     *         adds the points that see at least one face to mConflictLists
+     *         with their conflicts in the given order.
+     *
+     *  @param  points   (in):  the set of points in LCS.
+     *
+     *  @param  indices  (in):  the IDs of the points.
+     */
+    void addConflictPoints(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for addPoints()
+     *
+     *         clears mConflictLists and registers all the faces of
+     *         the manifold to it. It also sets mConflictCenter, and
+     *         enables the walk of addConflictPointsByWalk() if it is
+     *         strictly behind all the faces.
+     */
+    void registerConflictFaces();
+
+
+    /** @brief subroutine for addPoints()
+     *
+     *         adds the points that see at least one face to mConflictLists
+     *         with their conflicts as addConflictPoints() does, but
+     *         without testing all the faces.
+     *
+     *         For the interior point c = mConflictCenter, the face F with
+     *         the unit normal n and a point s on it is mapped to the
+     *         vertex n / n.(s - c) of the polar dual, and the faces
+     *         sharing an edge to the adjacent vertices. The face that
+     *         maximizes n.(p - c) / n.(s - c) is then found by
+     *         hill-climbing on the dual, which is convex, and it is the
+     *         face the ray from c to p leaves the hull from. The point is
+     *         inside if the face does not face it. Otherwise the faces
+     *         it sees are connected, and they are collected by the
+     *         breadth-first search from the face. Each walk starts from
+     *         the face found for the previous point.
+     *
+     *         The cost per point is the length of the walk times the
+     *         degree of the faces plus the size of the visible region.
+     *         It calls addConflictPoints() if mConflictWalkEnabled is
+     *         false.
+     *
+     *  @param  points   (in):  the set of points in LCS.
+     *
+     *  @param  indices  (in):  the IDs of the points.
+     */
+    void addConflictPointsByWalk(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         collects the points of the vertices of the face in the
+     *         order of its incident half edges.
+     */
+    void getFaceVertexPoints(const FaceIt& fit, vector<Vec3>& vertices);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         classifies the given points in mConflictLists against the
+     *         face with classifyPointBlock(), and adds the conflicts
+     *         for the points facing it in the given order.
+     *         It is equivalent to testing each point with isFacing()
+     *         and pred == NONE.
+     *
+     *  @param  fit          (in): the face already added to mConflictLists
+     *
+     *  @param  pointIndices (in): the indices of the points to be tested.
+     *
+     *  @param  numPoints    (in): the number of the indices.
+     */
+    void addConflictsForFace(
+        const FaceIt&                       fit,
+        const long*                         pointIndices,
+        const long                          numPoints
+    );
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         permutes the points and their IDs in place with
+     *         Fisher-Yates shuffle driven by std::mt19937_64 seeded with
+     *         mInsertionSeed. The random engine is fully specified by the
+     *         standard, so the result is reproducible across platforms.
+     *
+     *  @param  points   (in/out): the set of points in LCS.
+     *
+     *  @param  indices  (in/out): the IDs of the points.
+     */
+    void shufflePoints(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         Akl-Toussaint heuristic. It finds the convex hull of the
+     *         extremal points specified by mInteriorCulling and the 4 points
+     *         of the initial 3-simplex, and marks the points that are
+     *         strictly inside of it. The planes are held in flat arrays
+     *         and the points are tested against them in one sweep.
+     *
+     *  @param  points   (in):  the set of points in LCS.
+     *
+     *  @param  index1-4 (in):  the points of the initial 3-simplex.
+     *
+     *  @param  culled   (out): 1 if the point is strictly inside.
+     *
+     *  @return the number of points culled.
+     */
+    long cullInteriorPoints(
+        vector<Vec3>&                       points,
+        const size_t                        index1,
+        const size_t                        index2,
+        const size_t                        index3,
+        const size_t                        index4,
+        vector<unsigned char>&              culled
+    );
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         inserts the points one by one into the current manifold
+     *         tracking the conflicts with mConflictGraph.
+     */
+    void insertPointsByConflictGraph(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         inserts the points one by one into the current manifold
+     *         tracking the conflicts with mConflictLists.
+     */
+    void insertPointsByConflictLists(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for findConvexHull() and addPoints()
+     *
+     *         inserts the points in mConflictLists from the given index
+     *         to the last one into the current manifold.
+     */
+    void insertConflictPoints(const long first);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         inserts the point in mConflictLists of the given index into
+     *         the current manifold, and removes it from mConflictLists.
+     */
+    void insertConflictPoint(const long pointIndex);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         inserts the points in the farthest-outside-first order
+     *         tracking the conflicts with mConflictLists until the budget
+     *         set by setHullBudget() is reached. The points are kept in a
+     *         priority queue keyed by the distance from the planes of the
+     *         faces they see. The keys are updated lazily when the points
+     *         are popped.
+     *         It then finds approximationError(), and expands the hull
+     *         for HULL_APPROXIMATION_EXPANDED.
+     */
+    void insertPointsFarthestFirst(
+        vector<Vec3>&                       points,
+        vector<long>&                       indices
+    );
+
+
+    /** @brief subroutine for insertPointsFarthestFirst()
+     *
+     *  @return the largest signed distance of the point in mConflictLists
+     *          from the planes of the faces it sees.
+     */
+    double distanceToConflictFaces(const long pointIndex);
+
+
+    /** @brief subroutine for insertPointsFarthestFirst()
+     *
+     *  @return true if the hull has reached the budget.
+     */
+    inline bool isHullBudgetReached() const;
+
+
+    /** @brief subroutine for insertPointsFarthestFirst()
+     *
+     *         scales the hull about the centroid of its vertices so that
+     *         it encloses the points remaining in mConflictLists.
+     */
+    void expandHullToConflictPoints();
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         CONFLICT_LISTS version of findVisibleFaces().
+     *
+     *  @param  pointIndex    (in):  index of the point in mConflictLists.
+     *
+     *  @param  conflictFaces (out): the set of visible faces.
+     *
+     *  @return true  : abort. The vertex too close to a face.
+     *          false : continue processing the vertex.
+     */
+    bool findVisibleFaces(
+        const long      pointIndex,
+        vector<FaceIt>& conflictFaces
+    );
+
+
     /** @brief subroutine for findConvexHull()
      *
      *         It finds the set of faces that are visible to the given vertex
@@ -1073,6 +2046,8 @@ class Manifold : public Loggable {
      *         newly created. The new faces are discovered from the boundary
      *         half edges. The pointers to the boundary half edges are stored
      *         in the FrontierElems in the parameter frontier.
+     *         In CONFLICT_LISTS mode, the faces are added to mConflictLists
+     *         instead.
      *
      *  @param  frontier (in/out):: the target vertex to be tested.
      */
@@ -1081,7 +2056,8 @@ class Manifold : public Loggable {
 
     /** @brief subroutine for findConvexHull()
      *
-     *         It removes all the nodes and edges from mConflictGraph.
+     *         It removes all the nodes and edges from mConflictGraph,
+     *         and clears mConflictLists.
      *         This is part of the clearning up process of findConvexHull.
      */
     void clearConflictGraph();
@@ -1104,6 +2080,62 @@ class Manifold : public Loggable {
     bool vertexIsTooCloseToFace(const Vec3& pTest, FaceIt fit);
 
 
+    /** @brief subroutine for findConvexHull()
+     *
+     *         finds 3 vertices of the face that span its plane. They are
+     *         the first two vertices and the one furthest from the line
+     *         through them, in the counter-clockwise ordering.
+     */
+    void getFacePlanePoints(const FaceIt& fit, Vec3& a, Vec3& b, Vec3& c);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         Face::isFacing() with mEpsilonCHMargin, or orientToPlane()
+     *         against getFacePlanePoints() for the exact predicates.
+     *
+     *  @param pred (out): MAYBE_COPLANAR if the point is coplanar.
+     *                     NONE otherwise.
+     *
+     *  @return true if the point is facing the face.
+     */
+    bool isFaceFacing(const FaceIt& fit, const Vec3& p, enum predicate& pred);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         Face::isCoplanar(), or for the exact predicates,
+     *         MAYBE_COPLANAR if all the vertices of f2 are exactly on the
+     *         plane of f1 and NONE otherwise.
+     */
+    enum predicate facesCoplanarity(const FaceIt& f1, const FaceIt& f2);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         orient3d() or orient3dInteger() by mPredicateMode.
+     */
+    int orientToPlane(
+        const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& p);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         orient3dBlock() or orient3dIntegerBlock() by mPredicateMode.
+     */
+    void orientBlockToPlane(
+        const Vec3&    a,
+        const Vec3&    b,
+        const Vec3&    c,
+        const double*  xs,
+        const double*  ys,
+        const double*  zs,
+        const long     numPoints,
+        uint64_t&      positive,
+        uint64_t&      zero
+    );
+
+
     /** @brief subroutine for findConvexHull()
      *
      *         tests if two adjacent faces are in parallel or facing toward
@@ -1178,10 +2210,15 @@ class Manifold : public Loggable {
      *  @param  halfEdges  (in): circular list of half edges that represent
      *                           the frontier.
      *
-     *  @return list of FrontierElems, each of which contains the frontier
-     *          half edge and its associated points that may face the new face.
+     *  @param  elements  (out): list of FrontierElems, each of which
+     *                           contains the frontier half edge and its
+     *                           associated points that may face the new
+     *                           face. The contents are replaced.
      */
-    vector<FrontierElem> makeFrontier(vector<HalfEdgeIt>& halfEdges);
+    void makeFrontier(
+        vector<HalfEdgeIt>&   halfEdges,
+        vector<FrontierElem>& elements
+    );
 
 
     /** @brief subroutine for findConvexHull()
@@ -1242,9 +2279,16 @@ class Manifold : public Loggable {
      *         or cycle into one with associated face conflicts in the
      *         conflict graph.
      *
-     *  @param faces (in): ordered list of consecutive faces to be merged.
+     *  @param faces (in): ordered list of consecutive faces to be merged.
+     */
+    void mergeConsecutiveFaces(vector<FaceIt>& faces);
+
+
+    /** @brief subroutine for findConvexHull()
+     *
+     *         CONFLICT_LISTS version of mergeConsecutiveFaces().
      */
-    void mergeConsecutiveFaces(vector<FaceIt>& faces);
+    void mergeConsecutiveFacesByConflictLists(vector<FaceIt>& faces);
 
 
     /** @brief subroutine for findConvexHull()
@@ -1329,17 +2373,28 @@ class Manifold : public Loggable {
     /** @brief integer ID of this manifold. */
     long                                   mId;
 
+    /** @brief allocation of the features. */
+    enum FeatureAllocation                 mFeatureAllocation;
+
+    /** @brief what clear() does with the memory. */
+    enum WorkspaceMode                     mWorkspaceMode;
+
+    /** @brief pool for the features and the list nodes. It must be
+     *         declared before the lists so that it outlives them.
+     */
+    FeaturePool                            mFeaturePool;
+
     /** @brief Vertices in this manifold */
-    list<unique_ptr<Vertex> >              mVertices;
+    FeatureList<Vertex>                    mVertices;
 
     /** @brief Edges in this manifold */
-    list<unique_ptr<Edge> >                mEdges;
+    FeatureList<Edge>                      mEdges;
 
     /** @brief HalfEdges in this manifold */
-    list<unique_ptr<HalfEdge> >            mHalfEdges;
+    FeatureList<HalfEdge>                  mHalfEdges;
 
     /** @brief Faces in this manifold */
-    list<unique_ptr<Face> >                mFaces;
+    FeatureList<Face>                      mFaces;
 
     /** @brief Number of faces in this manifold */
     long                                   mNumFaces;
@@ -1353,20 +2408,130 @@ class Manifold : public Loggable {
     /** @brief conflict graph used to find the convex hull. */
     Directed::DiGraph                      mConflictGraph;
 
+    /** @brief flat conflict lists used to find the convex hull. */
+    ConflictLists                          mConflictLists;
+
+    /** @brief specifies which of the above is used. */
+    enum ConflictTrackingMode              mConflictTrackingMode;
+
+    /** @brief insertion order of the points in findConvexHull(). */
+    enum InsertionOrder                    mInsertionOrder;
+
+    /** @brief seed for INSERTION_ORDER_SHUFFLED. */
+    unsigned long                          mInsertionSeed;
+
+    /** @brief interior culling in findConvexHull(). */
+    enum InteriorCulling                   mInteriorCulling;
+
+    /** @brief number of points culled in the last findConvexHull(). */
+    long                                   mNumPointsCulled;
+
+    /** @brief predicates used in findConvexHull(). */
+    enum PredicateMode                     mPredicateMode;
+
+    /** @brief statistics of the last findConvexHull() or addPoints(). */
+    HullStats                              mHullStats;
+
+    /** @brief true if the wall times in mHullStats are measured. */
+    bool                                   mHullStatsEnabled;
+
+    /** @brief counters of findSupportVertex(). */
+    SupportStats                           mSupportStats;
+
+    /** @brief approximation of the hull in findConvexHull(). */
+    enum HullApproximation                 mHullApproximation;
+
+    /** @brief maximum number of vertices. 0 for no limit. */
+    long                                   mMaxHullVertices;
+
+    /** @brief maximum number of faces. 0 for no limit. */
+    long                                   mMaxHullFaces;
+
+    /** @brief points within this distance from the hull are not inserted.*/
+    double                                 mHullTolerance;
+
+    /** @brief approximation error in the last findConvexHull(). */
+    double                                 mApproximationError;
+
+    /** @brief expansion factor in the last findConvexHull(). */
+    double                                 mApproximationScale;
+
+    /** @brief true if all the faces of the manifold are registered in
+     *         mConflictLists for addPoints().
+     */
+    bool                                   mConflictFacesRegistered;
+
+    /** @brief a point strictly inside of the hull for the walk of
+     *         addConflictPointsByWalk(). It stays inside as the hull
+     *         grows.
+     */
+    Vec3                                   mConflictCenter;
+
+    /** @brief true if mConflictCenter is strictly behind all the faces. */
+    bool                                   mConflictWalkEnabled;
+
+    /** @brief points kept by addPoints() until the initial hull is made. */
+    vector<Vec3>                           mPendingPoints;
+
+    /** @brief IDs of mPendingPoints. */
+    vector<long>                           mPendingIndices;
+
+    /** @brief one past the largest ID given to addPoints() so far. */
+    long                                   mNextPointId;
+
+    /** @brief work space for addConflictsForFace(). */
+    vector<Vec3>                           mFaceVertexPoints;
+
+    /** @brief work spaces for findConvexHull(). They are kept as members
+     *         so that their capacities survive in WORKSPACE_RETAIN mode.
+     */
+    vector<long>                           mWorkIndices;
+    vector<unsigned char>                  mWorkCulled;
+    vector<Vec3>                           mWorkPoints;
+    vector<long>                           mWorkPointIndices;
+
+    /** @brief work spaces for addConflictPoints(). */
+    vector<vector<Vec3> >                  mWorkFaceVertices;
+    vector<uint64_t>                       mWorkFacingMasks;
+
+    /** @brief work spaces for addConflictPointsByWalk(). The marks are
+     *         indexed by mConflictIndex of the faces, and they are reset
+     *         after each point.
+     */
+    vector<unsigned char>                  mWorkFaceMarks;
+    vector<FaceIt>                         mWorkFaceRegion;
+
+    /** @brief work spaces for insertConflictPoint(). */
+    vector<FaceIt>                         mWorkConflictFaces;
+    vector<HalfEdgeIt>                     mWorkCircumference;
+    vector<FrontierElem>                   mWorkFrontier;
+    vector<long>                           mWorkFrontierPoints;
+
+    /** @brief work space for removeFaces(). */
+    vector<EdgeIt>                         mWorkEdges;
+
+    /** @brief work spaces for makePolygon(). */
+    vector<HalfEdgeIt>                     mWorkPolygonHalfEdges;
+    vector<Vec3>                           mWorkPolygonPoints;
+
+    /** @brief work spaces for cullInteriorPoints(). */
+    unique_ptr<Manifold>                   mCullingPolytope;
+    vector<Vec3>                           mWorkExtremalPoints;
+    vector<double>                         mWorkPlanes;
+
     /** @brief next number to be assigned to a newly created feature */
     long                                   mNextIdForFeatures;
 
-    /** @brief a map from a vertex pair to incident edge */
-    map<pair<long,long>,EdgeIt>            mVertexPairToEdge;
+    /** @brief a map from a vertex ID pair (smaller first) to the edge.
+     *         The pair is also the ID of the edge.
+     */
+    VertexPairMap<EdgeIt>                  mVertexPairToEdge;
 
     /** @brief a map from a vertex ID to VertexIt */
-    map<long,VertexIt>                     mVertexIdToVertex;
-
-    /** @brief a map from a vertex ID to EdgeIt */
-    map<pair<long,long>,EdgeIt>            mEdgeIdToEdge;
+    FeatureIdMap<VertexIt>                 mVertexIdToVertex;
 
     /** @brief a map from a face ID to FaceIt */
-    map<long,FaceIt>                       mFaceIdToFace;
+    FeatureIdMap<FaceIt>                   mFaceIdToFace;
 
     /** @brief used as the margin to test predicates
      *         when convex hull is generated.
@@ -1376,12 +2541,12 @@ class Manifold : public Loggable {
     /** @brief the edges to be removed are chained here.
      *         Used to merge two coplanar faces and remove 2-cycle faces.
      */
-    list<EdgeIt>                           mEdgesToBeRemoved;
+    EdgeItList                             mEdgesToBeRemoved;
 
     /** @brief the vertices to be removed are chained here.
      *         Used to remove deg-2 vertices.
      */
-    list<VertexIt>                         mVerticesToBeRemoved;
+    VertexItList                           mVerticesToBeRemoved;
 
 
 #ifdef UNIT_TESTS
@@ -1410,6 +2575,11 @@ class Manifold : public Loggable {
 
 
     /** @brief constructs the initial 3-simplex and the conflict graph
+     *
+     *         The conflict tracking mode is set to CONFLICT_GRAPH for the
+     *         steps, and the previous mode is restored by
+     *         debugFindConvexHullTerm(), or here if the points are
+     *         degenerate.
      *
      *  @param points (in) points for which the convex hull is to be found
      */
@@ -1444,7 +2614,9 @@ class Manifold : public Loggable {
 
 
     /** @brief terminates the function of findConvexHull()
-     *         It removes all the nodes from mConflictGraph
+     *         It removes all the nodes from mConflictGraph, and restores
+     *         the conflict tracking mode saved by
+     *         debugFindConvexHullStep1().
      */
     void debugFindConvexHullTerm();
 
@@ -1734,7 +2906,7 @@ inline Vec3  Vertex::nGCS(const Mat3x3&rot) const
 }
 
 
-inline const list<HalfEdgeIt>& Vertex::halfEdges(){return mIncidentHalfEdges;}
+inline const HalfEdgeItList& Vertex::halfEdges(){return mIncidentHalfEdges;}
 
 
 inline void Vertex::pushHalfEdgesCCW(const EdgeIt& e) {
@@ -2042,7 +3214,7 @@ inline Vec3  Face::nGCS(const Mat3x3&rot) const
     return rot * mNormalLCS;
 }
 
-inline list<HalfEdgeIt>& Face::halfEdges() { return mIncidentHalfEdges; }
+inline HalfEdgeItList& Face::halfEdges() { return mIncidentHalfEdges; }
 
 inline long Face::textureID() const { return mTextureID; }
 
@@ -2069,22 +3241,503 @@ inline bool Face::isIncident(EdgeIt eit)
 }
 
 
+inline HullStats::HullStats() { clear(); }
+
+
+inline void HullStats::clear()
+{
+    for (long i = 0; i < NUM_PHASES; i++) {
+        mPhaseSeconds[i] = 0.0;
+    }
+    mTotalSeconds        = 0.0;
+    mNumConflictsCreated = 0;
+    mNumInsertionAborts  = 0;
+    mNumMergeAborts      = 0;
+    mNumFaceMerges       = 0;
+    mNumVerticesRemoved  = 0;
+}
+
+
+inline SupportStats::SupportStats() { clear(); }
+
+
+inline void SupportStats::clear()
+{
+    mNumQueries        = 0;
+    mNumSteps          = 0;
+    mNumVerticesTested = 0;
+}
+
+
+inline const char* HullStats::phaseName(enum Phase phase)
+{
+    switch (phase) {
+      case PHASE_ANALYZE_POINTS:    return "analyzePoints";
+      case PHASE_INITIAL_CONFLICTS: return "initialConflicts";
+      case PHASE_VISIBLE_FACES:     return "visibleFaces";
+      case PHASE_FAN_CREATION:      return "fanCreation";
+      case PHASE_CONFLICT_UPDATE:   return "conflictUpdate";
+      case PHASE_FACE_MERGES:       return "faceMerges";
+      default:                      return "unknown";
+    }
+}
+
+
+inline ConflictLists::ConflictLists():mNumFacesRemoved(0){;}
+
+
+inline void ConflictLists::clear()
+{
+    clearPoints();
+    for (auto& points : mFacePoints) {
+        recycleArray(points);
+    }
+    mFaces.clear();
+    mFacePoints.clear();
+    mFaceRemoved.clear();
+    mNumFacesRemoved = 0;
+}
+
+
+inline void ConflictLists::release()
+{
+    vector<Vec3>().swap(mPoints);
+    vector<long>().swap(mIds);
+    vector<vector<long> >().swap(mPointFaces);
+    vector<unsigned char>().swap(mPointRemoved);
+    vector<unsigned char>().swap(mPointFound);
+    vector<FaceIt>().swap(mFaces);
+    vector<vector<long> >().swap(mFacePoints);
+    vector<unsigned char>().swap(mFaceRemoved);
+    vector<vector<long> >().swap(mSpareArrays);
+    mNumFacesRemoved = 0;
+}
+
+
+inline void ConflictLists::clearPoints()
+{
+    for (auto& faces : mPointFaces) {
+        recycleArray(faces);
+    }
+    mPoints.clear();
+    mIds.clear();
+    mPointFaces.clear();
+    mPointRemoved.clear();
+    mPointFound.clear();
+    for (auto& points : mFacePoints) {
+        points.clear();
+    }
+}
+
+
+inline vector<long> ConflictLists::takeSpareArray()
+{
+    if (mSpareArrays.empty()) {
+        return vector<long>();
+    }
+    vector<long> a(std::move(mSpareArrays.back()));
+    mSpareArrays.pop_back();
+    return a;
+}
+
+
+inline void ConflictLists::recycleArray(vector<long>& a)
+{
+    if (a.capacity() > 0) {
+        a.clear();
+        mSpareArrays.push_back(std::move(a));
+    }
+}
+
+
+inline long ConflictLists::addPoint(const Vec3& p, const long id)
+{
+    mPoints.push_back(p);
+    mIds.push_back(id);
+    mPointFaces.push_back(takeSpareArray());
+    mPointRemoved.push_back(false);
+    mPointFound.push_back(false);
+    return mPoints.size() - 1;
+}
+
+
+inline long ConflictLists::addFace(const FaceIt& fit)
+{
+    mFaces.push_back(fit);
+    mFacePoints.push_back(takeSpareArray());
+    mFaceRemoved.push_back(false);
+    return mFaces.size() - 1;
+}
+
+
+inline void ConflictLists::addConflict(
+    const long faceIndex,
+    const long pointIndex
+) {
+    mFacePoints[faceIndex].push_back(pointIndex);
+    mPointFaces[pointIndex].push_back(faceIndex);
+}
+
+
+inline void ConflictLists::removeFace(const long faceIndex)
+{
+    mFaceRemoved[faceIndex] = true;
+    mNumFacesRemoved++;
+    recycleArray(mFacePoints[faceIndex]);
+}
+
+
+inline void ConflictLists::removePoint(const long pointIndex)
+{
+    mPointRemoved[pointIndex] = true;
+    recycleArray(mPointFaces[pointIndex]);
+}
+
+
+inline const vector<long>& ConflictLists::faces(const long pointIndex)
+{
+    auto& faces = mPointFaces[pointIndex];
+    size_t j = 0;
+    for (size_t i = 0; i < faces.size(); i++) {
+        if (!mFaceRemoved[faces[i]]) {
+            faces[j++] = faces[i];
+        }
+    }
+    faces.resize(j);
+    return faces;
+}
+
+
+inline const vector<long>& ConflictLists::points(const long faceIndex) const
+{
+    return mFacePoints[faceIndex];
+}
+
+
+inline const Vec3& ConflictLists::p(const long pointIndex) const
+{
+    return mPoints[pointIndex];
+}
+
+
+inline long ConflictLists::id(const long pointIndex) const
+{
+    return mIds[pointIndex];
+}
+
+
+inline FaceIt ConflictLists::face(const long faceIndex) const
+{
+    return mFaces[faceIndex];
+}
+
+
+inline bool ConflictLists::isPointRemoved(const long pointIndex) const
+{
+    return mPointRemoved[pointIndex];
+}
+
+
+inline long ConflictLists::numPoints() const
+{
+    return mPoints.size();
+}
+
+
+inline long ConflictLists::numFaces() const
+{
+    return mFaces.size();
+}
+
+
+inline long ConflictLists::numFacesRemoved() const
+{
+    return mNumFacesRemoved;
+}
+
+
 inline Manifold::Manifold(std::ostream& logStream):
     Loggable(logStream),
+    mFeatureAllocation(FEATURE_ALLOCATION_POOL),
+    mWorkspaceMode(WORKSPACE_RELEASE),
+    mVertices (FeatureAllocator<FeaturePtr<Vertex  > >(&mFeaturePool)),
+    mEdges    (FeatureAllocator<FeaturePtr<Edge    > >(&mFeaturePool)),
+    mHalfEdges(FeatureAllocator<FeaturePtr<HalfEdge> >(&mFeaturePool)),
+    mFaces    (FeatureAllocator<FeaturePtr<Face    > >(&mFeaturePool)),
     mNumFaces(0),
     mPred(NONE),
+    mConflictTrackingMode(CONFLICT_LISTS),
+    mInsertionOrder(INSERTION_ORDER_SHUFFLED),
+    mInsertionSeed(DEFAULT_INSERTION_SEED),
+    mInteriorCulling(INTERIOR_CULLING_14DOP),
+    mNumPointsCulled(0),
+    mPredicateMode(PREDICATES_EPSILON),
+    mHullStatsEnabled(false),
+    mHullApproximation(HULL_APPROXIMATION_NONE),
+    mMaxHullVertices(0),
+    mMaxHullFaces(0),
+    mHullTolerance(0.0),
+    mApproximationError(0.0),
+    mApproximationScale(1.0),
+    mConflictFacesRegistered(false),
+    mConflictWalkEnabled(false),
+    mNextPointId(0),
     mNextIdForFeatures(0),
-    mEpsilonCHMargin(EPSILON_SQUARED*100.0){;}
+    mEpsilonCHMargin(EPSILON_SQUARED*100.0),
+    mEdgesToBeRemoved   (FeatureAllocator<EdgeIt  >(&mFeaturePool)),
+    mVerticesToBeRemoved(FeatureAllocator<VertexIt>(&mFeaturePool)){;}
 
 
 inline Manifold::~Manifold() {;}
 
 
+inline void Manifold::setFeatureAllocation(
+                                        enum FeatureAllocation allocation)
+{
+    clear();
+    mFeatureAllocation = allocation;
+    FeaturePool* pool =
+         (allocation == FEATURE_ALLOCATION_POOL) ? &mFeaturePool : nullptr;
+
+    // The lists take the new allocators by the move assignment.
+    mVertices  = FeatureList<Vertex  >(
+                                 FeatureAllocator<FeaturePtr<Vertex  > >(pool));
+    mEdges     = FeatureList<Edge    >(
+                                 FeatureAllocator<FeaturePtr<Edge    > >(pool));
+    mHalfEdges = FeatureList<HalfEdge>(
+                                 FeatureAllocator<FeaturePtr<HalfEdge> >(pool));
+    mFaces     = FeatureList<Face    >(
+                                 FeatureAllocator<FeaturePtr<Face    > >(pool));
+    mEdgesToBeRemoved    = EdgeItList  (FeatureAllocator<EdgeIt  >(pool));
+    mVerticesToBeRemoved = VertexItList(FeatureAllocator<VertexIt>(pool));
+}
+
+
+inline size_t Manifold::featurePoolBytes() const
+{
+    return mFeaturePool.numBytesReserved();
+}
+
+
+inline void Manifold::setWorkspaceMode(enum WorkspaceMode mode)
+{
+    mWorkspaceMode = mode;
+}
+
+
+inline void Manifold::releaseWorkspace()
+{
+    mConflictLists.release();
+    mConflictFacesRegistered = false;
+    vector<long>().swap(mWorkIndices);
+    vector<unsigned char>().swap(mWorkCulled);
+    vector<Vec3>().swap(mWorkPoints);
+    vector<long>().swap(mWorkPointIndices);
+    vector<vector<Vec3> >().swap(mWorkFaceVertices);
+    vector<uint64_t>().swap(mWorkFacingMasks);
+    vector<unsigned char>().swap(mWorkFaceMarks);
+    vector<FaceIt>().swap(mWorkFaceRegion);
+    vector<FaceIt>().swap(mWorkConflictFaces);
+    vector<HalfEdgeIt>().swap(mWorkCircumference);
+    vector<FrontierElem>().swap(mWorkFrontier);
+    vector<long>().swap(mWorkFrontierPoints);
+    vector<EdgeIt>().swap(mWorkEdges);
+    vector<HalfEdgeIt>().swap(mWorkPolygonHalfEdges);
+    vector<Vec3>().swap(mWorkPolygonPoints);
+    vector<Vec3>().swap(mWorkExtremalPoints);
+    vector<double>().swap(mWorkPlanes);
+    mCullingPolytope.reset();
+}
+
+
+template<class T, class... Args>
+inline FeaturePtr<T> Manifold::makeFeature(Args&&... args)
+{
+    if (mFeatureAllocation == FEATURE_ALLOCATION_HEAP) {
+        return FeaturePtr<T>(new T(std::forward<Args>(args)...),
+                             FeatureDeleter<T>());
+    }
+    void* mem = mFeaturePool.allocate(sizeof(T));
+    T*    p;
+    try {
+        p = new (mem) T(std::forward<Args>(args)...);
+    }
+    catch (...) {
+        mFeaturePool.deallocate(mem, sizeof(T));
+        throw;
+    }
+    FeaturePtr<T> fp(p, FeatureDeleter<T>(&mFeaturePool));
+    attachFeaturePool(*p);
+    return fp;
+}
+
+
+inline void Manifold::attachFeaturePool(Vertex& v)
+{
+    v.mIncidentHalfEdges =
+                   HalfEdgeItList(FeatureAllocator<HalfEdgeIt>(&mFeaturePool));
+}
+
+
+inline void Manifold::attachFeaturePool(Face& f)
+{
+    f.mIncidentHalfEdges =
+                   HalfEdgeItList(FeatureAllocator<HalfEdgeIt>(&mFeaturePool));
+}
+
+
+inline void Manifold::setConflictTrackingMode(
+                                          enum ConflictTrackingMode mode)
+{
+    mConflictTrackingMode = mode;
+}
+
+
+inline void Manifold::setInsertionOrder(
+    enum InsertionOrder order,
+    const unsigned long seed
+) {
+    mInsertionOrder = order;
+    mInsertionSeed  = seed;
+}
+
+
+inline void Manifold::setInteriorCulling(enum InteriorCulling culling)
+{
+    mInteriorCulling = culling;
+}
+
+
+inline long Manifold::numPointsCulled() const
+{
+    return mNumPointsCulled;
+}
+
+
+inline void Manifold::setPredicateMode(enum PredicateMode mode)
+{
+    mPredicateMode = mode;
+}
+
+
+inline void Manifold::setHullBudget(
+    enum HullApproximation approx,
+    const long             maxVertices,
+    const long             maxFaces,
+    const double           tolerance
+) {
+    mHullApproximation = approx;
+    mMaxHullVertices   = maxVertices;
+    mMaxHullFaces      = maxFaces;
+    mHullTolerance     = tolerance;
+}
+
+
+inline double Manifold::approximationError() const
+{
+    return mApproximationError;
+}
+
+
+inline double Manifold::approximationScale() const
+{
+    return mApproximationScale;
+}
+
+
+inline void Manifold::logContents(
+    enum LogLevel lvl,
+    const char*,
+    const int
+) {
+    if (isLogEnabled(lvl)) {
+        writeContents();
+    }
+}
+
+
+inline void Manifold::logConflictGraph(
+    enum LogLevel lvl,
+    const char*,
+    const int
+) {
+    if (isLogEnabled(lvl)) {
+        writeConflictGraph();
+    }
+}
+
+
+inline void Manifold::logVertexConflict(
+    enum LogLevel   lvl,
+    const char*,
+    const int,
+    VertexConflict& VC
+) {
+    if (isLogEnabled(lvl)) {
+        writeVertexConflict(VC);
+    }
+}
+
+
+inline void Manifold::logVertexConflict(
+    enum LogLevel   lvl,
+    const char*,
+    const int,
+    const long      pointIndex
+) {
+    if (isLogEnabled(lvl)) {
+        writeVertexConflict(pointIndex);
+    }
+}
+
+
+inline void Manifold::setHullStatsEnabled(const bool enabled)
+{
+    mHullStatsEnabled = enabled;
+}
+
+
+inline const HullStats& Manifold::hullStats() const
+{
+    return mHullStats;
+}
+
+
+inline const SupportStats& Manifold::supportStats() const
+{
+    return mSupportStats;
+}
+
+
+inline void Manifold::clearSupportStats()
+{
+    mSupportStats.clear();
+}
+
+
+inline bool Manifold::isHullBudgetReached() const
+{
+    return (mMaxHullVertices > 0 && (long)mVertices.size()>=mMaxHullVertices)
+        || (mMaxHullFaces    > 0 && (long)mFaces.size()   >=mMaxHullFaces   );
+}
+
+
+inline long Manifold::numPendingPoints() const
+{
+    return mPendingPoints.size();
+}
+
+
 inline void Manifold::clear() {
+    mEdgesToBeRemoved.clear();
+    mVerticesToBeRemoved.clear();
     mVertices.clear();
     mEdges.clear();
     mHalfEdges.clear();
     mFaces.clear();
+    mVertexIdToVertex.clear();
+    mVertexPairToEdge.clear();
+    mFaceIdToFace.clear();
     const auto& nPair = mConflictGraph.nodes();
     std::vector<Wailea::Undirected::node_list_it_t> gNodes;
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
@@ -2093,6 +3746,16 @@ inline void Manifold::clear() {
     for (auto nit : gNodes) {
         mConflictGraph.removeNode(*(*nit));
     }
+    mConflictLists.clear();
+    mConflictFacesRegistered = false;
+    if (mWorkspaceMode == WORKSPACE_RELEASE) {
+        // The features have been returned to the pool above.
+        mFeaturePool.release();
+        releaseWorkspace();
+    }
+    mPendingPoints.clear();
+    mPendingIndices.clear();
+    mNextPointId = 0;
     mNumFaces = 0;
     mNextIdForFeatures = 0;
     mPred = NONE;
@@ -2162,44 +3825,37 @@ inline FaceIt Manifold::makeTriangle(
               const HalfEdgeIt& e1, const HalfEdgeIt& e2, const HalfEdgeIt& e3)
 {
 
-    list<HalfEdgeIt> edges;
-
-    edges.push_back(e1);
-    edges.push_back(e2);
-    edges.push_back(e3);
+    const HalfEdgeIt edges[3] = { e1, e2, e3 };
 
-    return makePolygon(edges);
+    return makePolygon(edges, 3);
 
 }
 
 inline FaceIt Manifold::makeTriangle(
               const EdgeIt& e1, const EdgeIt& e2, const EdgeIt& e3)
 {
-    list<EdgeIt> edges;
+    const EdgeIt edges[3] = { e1, e2, e3 };
+    HalfEdgeIt   halfEdges[3];
 
-    edges.push_back(e1);
-    edges.push_back(e2);
-    edges.push_back(e3);
+    Face::halfEdgesFromEdges(edges, 3, halfEdges);
 
-    return makePolygon(edges);
+    return makePolygon(halfEdges, 3);
 }
 
 inline FaceIt Manifold::makeQuad(
        const EdgeIt& e1, const EdgeIt& e2, const EdgeIt& e3, const EdgeIt& e4)
 {
-    list<EdgeIt> edges;
+    const EdgeIt edges[4] = { e1, e2, e3, e4 };
+    HalfEdgeIt   halfEdges[4];
 
-    edges.push_back(e1);
-    edges.push_back(e2);
-    edges.push_back(e3);
-    edges.push_back(e4);
+    Face::halfEdgesFromEdges(edges, 4, halfEdges);
 
-    return makePolygon(edges);
+    return makePolygon(halfEdges, 4);
 }
 
 
 inline VertexIt Manifold::makeVertex(const Vec3& p, const long id) {
-    auto vp = make_unique<Vertex>(p);
+    auto vp = makeFeature<Vertex>(p);
     auto vit = mVertices.insert(mVertices.end(), std::move(vp));
     if (id == -1) {
         (*vit)->setId(mNextIdForFeatures++);
@@ -2214,15 +3870,15 @@ inline VertexIt Manifold::makeVertex(const Vec3& p, const long id) {
 
 inline EdgeIt Manifold::makeEdge(const VertexIt& v1, const VertexIt& v2) {
 
-    auto ep = make_unique<Edge>();
+    auto ep = makeFeature<Edge>();
     auto eit = mEdges.insert(mEdges.end(), std::move(ep));
     (*eit)->mBackIt = eit;
 
-    auto hep1 = make_unique<HalfEdge>();
+    auto hep1 = makeFeature<HalfEdge>();
     hep1->setVerticesAndEdge(v1, v2, eit);
     auto heit1 = mHalfEdges.insert(mHalfEdges.end(), std::move(hep1));
 
-    auto hep2 = make_unique<HalfEdge>();
+    auto hep2 = makeFeature<HalfEdge>();
     hep2->setVerticesAndEdge(v2, v1, eit);
     auto heit2 = mHalfEdges.insert(mHalfEdges.end(), std::move(hep2));
 
@@ -2298,17 +3954,20 @@ inline pair<FaceIt, FaceIt>   Manifold::faces()
 
 inline VertexIt Manifold::vertexIt(long id)
 {
-    return mVertexIdToVertex[id];
+    auto p = mVertexIdToVertex.find(id);
+    return (p != nullptr) ? *p : mVertices.end();
 }
 
 inline EdgeIt   Manifold::edgeIt  (const pair<long,long>& id)
 {
-    return mEdgeIdToEdge[id];
+    auto p = mVertexPairToEdge.find(id);
+    return (p != nullptr) ? *p : mEdges.end();
 }
 
 inline FaceIt Manifold::faceIt  (long id)
 {
-    return mFaceIdToFace[id];
+    auto p = mFaceIdToFace.find(id);
+    return (p != nullptr) ? *p : mFaces.end();
 }
 
 inline void Manifold::setNormalsForVerticesAndEdges()
@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <thread>
+#include <tuple>
+
 #include "manifold.hpp"
+#include "point_classifier.hpp"
+#include "geometric_predicates.hpp"
 /**
  * @file manifold_convex_hull.cpp
  *
@@ -11,27 +20,6 @@ namespace Makena {
 using namespace Wailea;
 
 
-/* @class FrontierElem
- *
- * @brief temporarily holds the visible vertices to the two faces adjacent 
- *        to the edge specified by the half edge.
- *        This is used to transfer the visible vertices from the old face
- *        to the new one around the frontier.
- */
-class FrontierElem {
-  public:
-
-    /** @brief the half edge */
-    HalfEdgeIt                         mHeit;
-
-    /** @brief the set of visible vertices to the faces incident to
-     *         the half edge.
-     */
-    vector<Undirected::node_list_it_t> mFacingVertices;
-
-};
-
-
 /** @class FaceConflict
  *
  *  @brief represents a face of the current manifold  in the conflict graph
@@ -69,10 +57,44 @@ class VertexConflict : public Directed::DiNode {
 };
 
 
+/** @class HullTimer
+ *
+ *  @brief adds the wall time of its scope in seconds to the given
+ *         accumulator of HullStats if enabled. Otherwise it does nothing.
+ */
+class HullTimer {
+
+  public:
+    inline HullTimer(double& seconds, const bool enabled):
+        mSeconds(seconds), mEnabled(enabled)
+    {
+        if (mEnabled) {
+            mStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline ~HullTimer()
+    {
+        if (mEnabled) {
+            const std::chrono::duration<double> elapsed =
+                                   std::chrono::steady_clock::now() - mStart;
+            mSeconds += elapsed.count();
+        }
+    }
+
+  private:
+    double&                               mSeconds;
+    const bool                            mEnabled;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+
 
 /** @brief constructs the convex hull of the given points as a manifold.
  *         It uses a randomized algorithm whose expected running time
- *         is O(n*log(n)).
+ *         is O(n*log(n)). The points are inserted in the order specified
+ *         by setInsertionOrder(), which is a seeded random permutation
+ *         by default.
  *
  *  @param points  (in):  the points.
  *
@@ -88,13 +110,293 @@ void Manifold::findConvexHull(
     vector<Vec3>&   points,
     enum predicate& pred,
     const double    epsilon
+) {
+    mWorkIndices.resize(points.size());
+    for (long i = 0; i < points.size(); i++) {
+        mWorkIndices[i] = i;
+    }
+
+    findConvexHull(points, mWorkIndices, pred, epsilon);
+}
+
+
+void Manifold::findConvexHullOfGridCells(
+    const vector<array<long, 3>>& cells,
+    const Vec3&                   origin,
+    const double                  pitch,
+    enum predicate&               pred
+) {
+    // Sort the cells and drop the duplicates.
+    vector<long> order(cells.size());
+    for (long i = 0; i < cells.size(); i++) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&cells](long i, long j) {
+        return cells[i] < cells[j] || (cells[i] == cells[j] && i < j);
+    });
+    order.erase(unique(order.begin(), order.end(), [&cells](long i, long j) {
+        return cells[i] == cells[j];
+    }), order.end());
+
+    // Mark the cells at the ends of the lines along each axis.
+    const long            numCells = order.size();
+    vector<unsigned char> extreme(numCells, 0);
+    vector<long>          line(numCells);
+    for (long axis = 0; axis < 3; axis++) {
+        const long a1 = (axis + 1) % 3;
+        const long a2 = (axis + 2) % 3;
+        for (long i = 0; i < numCells; i++) {
+            line[i] = i;
+        }
+        sort(line.begin(), line.end(), [&](long i, long j) {
+            auto& ci = cells[order[i]];
+            auto& cj = cells[order[j]];
+            return make_tuple(ci[a1], ci[a2], ci[axis]) <
+                   make_tuple(cj[a1], cj[a2], cj[axis]);
+        });
+        for (long begin = 0; begin < numCells; ) {
+            auto& cb  = cells[order[line[begin]]];
+            long  end = begin + 1;
+            while (end < numCells && cells[order[line[end]]][a1] == cb[a1]
+                                  && cells[order[line[end]]][a2] == cb[a2]) {
+                end++;
+            }
+            extreme[line[begin]  ] |= (1 << axis);
+            extreme[line[end - 1]] |= (1 << axis);
+            begin = end;
+        }
+    }
+
+    vector<Vec3> points;
+    vector<long> indices;
+    bool         inRange = true;
+    for (long i = 0; i < numCells; i++) {
+        if (extreme[i] == 0x7) {
+            auto& c = cells[order[i]];
+            for (long k = 0; k < 3; k++) {
+                inRange = inRange && labs(c[k]) < ORIENT3D_INTEGER_LIMIT;
+            }
+            points.emplace_back((double)c[0], (double)c[1], (double)c[2]);
+            indices.push_back(order[i]);
+        }
+    }
+
+    MAKENA_LOG(INFO,
+        "findConvexHullOfGridCells() %ld cells, %ld extreme",
+        (long)cells.size(), (long)points.size());
+
+    const auto mode = mPredicateMode;
+    mPredicateMode  = inRange ? PREDICATES_EXACT_INTEGER
+                              : PREDICATES_FILTERED_EXACT;
+    findConvexHull(points, indices, pred);
+    mPredicateMode  = mode;
+
+    // Uniform scaling and translation keep the normals.
+    for (auto& v : mVertices) {
+        v->mPointLCS = origin + v->mPointLCS * pitch;
+    }
+}
+
+
+/** @brief subroutine for findConvexHullParallel()
+ *
+ *         splits order[begin, end) into numParts contiguous ranges of
+ *         spatially separated points by the median splits along the
+ *         longest axis of the bounding box of each range recursively.
+ *
+ *  @param points   (in):     the points indexed by order.
+ *
+ *  @param order    (in/out): the indices to the points to be permuted.
+ *
+ *  @param begin    (in):     the beginning of the range in order.
+ *
+ *  @param end      (in):     the end of the range in order.
+ *
+ *  @param numParts (in):     the number of the ranges to split into.
+ *
+ *  @param bounds   (out):    the ends of the ranges are appended.
+ */
+static void splitPointsAlongLongestAxis(
+    const vector<Vec3>& points,
+    vector<long>&       order,
+    const size_t        begin,
+    const size_t        end,
+    const long          numParts,
+    vector<size_t>&     bounds
+) {
+    if (numParts <= 1) {
+        bounds.push_back(end);
+        return;
+    }
+
+    Vec3 lo = points[order[begin]];
+    Vec3 hi = lo;
+    for (size_t i = begin; i < end; i++) {
+        auto& p = points[order[i]];
+        lo = Vec3(std::min(lo.x(), p.x()), std::min(lo.y(), p.y()),
+                  std::min(lo.z(), p.z()));
+        hi = Vec3(std::max(hi.x(), p.x()), std::max(hi.y(), p.y()),
+                  std::max(hi.z(), p.z()));
+    }
+    const Vec3 span = hi - lo;
+    int        axis = 1;
+    if (span.x() < span.y()) { axis = 2; }
+    if (std::max(span.x(), span.y()) < span.z()) { axis = 3; }
+    auto coord = [axis](const Vec3& p) {
+        return (axis == 1) ? p.x() : ((axis == 2) ? p.y() : p.z());
+    };
+
+    const long   leftParts = numParts / 2;
+    const size_t mid       = begin + (end - begin) * leftParts / numParts;
+
+    std::nth_element(order.begin() + begin, order.begin() + mid,
+                     order.begin() + end,
+                     [&points, &coord](const long a, const long b) {
+                         return coord(points[a]) < coord(points[b]);
+                     });
+
+    splitPointsAlongLongestAxis(
+                         points, order, begin, mid, leftParts, bounds);
+    splitPointsAlongLongestAxis(
+                         points, order, mid, end, numParts - leftParts, bounds);
+}
+
+
+void Manifold::findConvexHullParallel(
+    vector<Vec3>&   points,
+    enum predicate& pred,
+    const long      numThreads,
+    const double    epsilon
 ) {
     vector<long> indices;
     for (long i = 0; i < points.size(); i++) {
         indices.push_back(i);
     }
 
-    findConvexHull(points, indices, pred, epsilon);
+    findConvexHullParallel(points, indices, pred, numThreads, epsilon);
+}
+
+
+void Manifold::findConvexHullParallel(
+    vector<Vec3>&   points,
+    vector<long>&   indices,
+    enum predicate& pred,
+    const long      numThreads,
+    const double    epsilon
+) {
+    long numParts = numThreads;
+    if (numParts <= 0) {
+        numParts = std::max(1L, (long)std::thread::hardware_concurrency());
+    }
+    numParts = std::min(numParts, (long)points.size()/MIN_POINTS_PER_PARTITION);
+
+    if (numParts <= 1) {
+        findConvexHull(points, indices, pred, epsilon);
+        return;
+    }
+
+    // The partitions hardly prune the points if most of them are on the
+    // hull. Estimate the ratio from the hull of a sample of the points.
+    {
+        const long   step = points.size() / MIN_POINTS_PER_PARTITION;
+        vector<Vec3> samplePoints;
+        vector<long> sampleIndices;
+        for (long i = 0; i < points.size(); i += step) {
+            samplePoints.push_back(points[i]);
+            sampleIndices.push_back(i);
+        }
+        Manifold       sample(mLogStream);
+        enum predicate samplePred;
+        sample.setPredicateMode(mPredicateMode);
+        sample.findConvexHull(samplePoints, sampleIndices, samplePred, epsilon);
+        if (samplePred == NONE) {
+            long numVertices = 0;
+            auto vPair = sample.vertices();
+            for (auto vit = vPair.first; vit != vPair.second; vit++) {
+                numVertices++;
+            }
+            if (numVertices >
+                    samplePoints.size() * MAX_HULL_RATIO_FOR_PARTITIONS) {
+                MAKENA_LOG(INFO, "findConvexHullParallel() %ld of %ld "
+                           "sample points on the hull. Not partitioned.",
+                           numVertices, (long)samplePoints.size());
+                findConvexHull(points, indices, pred, epsilon);
+                return;
+            }
+        }
+    }
+
+    MAKENA_LOG(INFO, "findConvexHullParallel() %ld partitions", numParts);
+
+    vector<long> order(points.size());
+    for (long i = 0; i < points.size(); i++) {
+        order[i] = i;
+    }
+    vector<size_t> bounds;
+    splitPointsAlongLongestAxis(
+                          points, order, 0, points.size(), numParts, bounds);
+
+    vector<vector<Vec3>> partPoints (numParts);
+    vector<vector<long>> partIndices(numParts);
+    size_t begin = 0;
+    for (long k = 0; k < numParts; k++) {
+        for (size_t i = begin; i < bounds[k]; i++) {
+            partPoints [k].push_back(points [order[i]]);
+            partIndices[k].push_back(indices[order[i]]);
+        }
+        begin = bounds[k];
+    }
+
+    // Find the hull of each partition concurrently.
+    vector<unique_ptr<Manifold>> parts;
+    vector<enum predicate>       partPreds(numParts, NONE);
+    for (long k = 0; k < numParts; k++) {
+        auto m = make_unique<Manifold>(mLogStream);
+        m->setConflictTrackingMode(mConflictTrackingMode);
+        m->setInsertionOrder(mInsertionOrder, mInsertionSeed);
+        m->setInteriorCulling(mInteriorCulling);
+        m->setPredicateMode(mPredicateMode);
+        m->setFeatureAllocation(mFeatureAllocation);
+        parts.push_back(std::move(m));
+    }
+
+    vector<std::thread> threads;
+    for (long k = 0; k < numParts; k++) {
+        threads.emplace_back([&, k]{
+            parts[k]->findConvexHull(
+                          partPoints[k], partIndices[k], partPreds[k], epsilon);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Collect the hull vertices. If a partition is degenerate, all of its
+    // points are passed to the final hull.
+    vector<Vec3> unionPoints;
+    vector<long> unionIndices;
+    long         numPartsCulled = 0;
+    for (long k = 0; k < numParts; k++) {
+        if (partPreds[k] == NONE) {
+            auto vPair = parts[k]->vertices();
+            for (auto vit = vPair.first; vit != vPair.second; vit++) {
+                unionPoints.push_back ((*vit)->pLCS());
+                unionIndices.push_back((*vit)->id());
+            }
+            numPartsCulled += parts[k]->numPointsCulled();
+        }
+        else {
+            unionPoints.insert (unionPoints.end(),
+                                partPoints[k].begin(),  partPoints[k].end());
+            unionIndices.insert(unionIndices.end(),
+                                partIndices[k].begin(), partIndices[k].end());
+        }
+    }
+    parts.clear();
+
+    findConvexHull(unionPoints, unionIndices, pred, epsilon);
+
+    mNumPointsCulled += numPartsCulled;
 }
 
 
@@ -104,9 +406,15 @@ void Manifold::findConvexHull(
     enum predicate& pred,
     const double    epsilon
 ) {
-    mEpsilonCHMargin = epsilon;
+    mEpsilonCHMargin    = epsilon;
+    mNumPointsCulled    = 0;
+    mApproximationError = 0.0;
+    mApproximationScale = 1.0;
+    mHullStats.clear();
 
-    log(INFO, __FILE__, __LINE__, "findConvexHull() BEGIN");
+    HullTimer timer(mHullStats.mTotalSeconds, mHullStatsEnabled);
+
+    MAKENA_LOG(INFO, "findConvexHull() BEGIN");
 
     if (points.size() < 4) {
         pred = MAYBE_FLAT;
@@ -115,7 +423,12 @@ void Manifold::findConvexHull(
 
     size_t index1, index2, index3,  index4;
 
-    pred = analyzePoints(points, index1, index2, index3, index4);
+    {
+        HullTimer timer(
+            mHullStats.mPhaseSeconds[HullStats::PHASE_ANALYZE_POINTS],
+            mHullStatsEnabled);
+        pred = analyzePoints(points, index1, index2, index3, index4);
+    }
     if (pred != NONE) {
         return;
     }
@@ -126,23 +439,294 @@ void Manifold::findConvexHull(
         indices[index1], indices[index2], indices[index3], indices[index4]
     );
 
-    log(INFO, __FILE__, __LINE__, "Initial 3-simplex");
+    MAKENA_LOG(INFO, "Initial 3-simplex");
     logContents(INFO, __FILE__, __LINE__);
 
+    // Discard the points that can not be on the hull.
+    auto& culled = mWorkCulled;
+    culled.assign(points.size(), 0);
+    if (mInteriorCulling != INTERIOR_CULLING_NONE) {
+        mNumPointsCulled = cullInteriorPoints(
+                       points, index1, index2, index3, index4, culled);
+        MAKENA_LOG(INFO, "Culled %ld points out of %ld",
+                   mNumPointsCulled, (long)points.size());
+    }
+
     // Remove the 4 points from the list, and generate conflict graph nodes.
-    vector<Vec3> pointsReduced;
-    vector<long> indicesReduced;
+    auto& pointsReduced  = mWorkPoints;
+    auto& indicesReduced = mWorkPointIndices;
+    pointsReduced.clear();
+    indicesReduced.clear();
     for (size_t i = 0; i < points.size(); i++) {
-        if (i != index1 && i != index2 && i != index3 && i != index4) {
+        if (i != index1 && i != index2 && i != index3 && i != index4 &&
+            culled[i] == 0                                               ) {
             pointsReduced.push_back (points [i]);
             indicesReduced.push_back(indices[i]);
         }
     }
 
+    if (mInsertionOrder == INSERTION_ORDER_SHUFFLED) {
+        shufflePoints(pointsReduced, indicesReduced);
+    }
+
+    if (mHullApproximation != HULL_APPROXIMATION_NONE) {
+        insertPointsFarthestFirst(pointsReduced, indicesReduced);
+    }
+    else if (mConflictTrackingMode == CONFLICT_GRAPH) {
+        insertPointsByConflictGraph(pointsReduced, indicesReduced);
+    }
+    else {
+        insertPointsByConflictLists(pointsReduced, indicesReduced);
+    }
+
+    // Tidy up
+    clearConflictGraph();
+
+    if (mWorkspaceMode == WORKSPACE_RELEASE) {
+        releaseWorkspace();
+    }
+
+    setNormalsForVerticesAndEdges();
+
+    constructHelperMaps();
+
+}
+
+
+void Manifold::addPoints(
+    vector<Vec3>&   points,
+    enum predicate& pred,
+    const double    epsilon
+) {
+    long firstId = mNextPointId;
+    for (auto& v : mVertices) {
+        firstId = std::max(firstId, v->id() + 1);
+    }
+
+    vector<long> indices;
+    for (long i = 0; i < points.size(); i++) {
+        indices.push_back(firstId + i);
+    }
+
+    addPoints(points, indices, pred, epsilon);
+}
+
+
+void Manifold::addPoints(
+    vector<Vec3>&   points,
+    vector<long>&   indices,
+    enum predicate& pred,
+    const double    epsilon
+) {
+    for (auto id : indices) {
+        mNextPointId = std::max(mNextPointId, id + 1);
+    }
+
+    if (mFaces.empty()) {
+
+        // No hull yet. Try again with all the points given so far.
+        mPendingPoints.insert (
+                         mPendingPoints.end(),  points.begin(),  points.end());
+        mPendingIndices.insert(
+                         mPendingIndices.end(), indices.begin(), indices.end());
+
+        findConvexHull(mPendingPoints, mPendingIndices, pred, epsilon);
+
+        if (pred == NONE) {
+            vector<Vec3>().swap(mPendingPoints);
+            vector<long>().swap(mPendingIndices);
+        }
+        return;
+    }
+
+    pred             = NONE;
+    mEpsilonCHMargin = epsilon;
+    mHullStats.clear();
+
+    HullTimer timer(mHullStats.mTotalSeconds, mHullStatsEnabled);
+
+    MAKENA_LOG(INFO, "addPoints() %ld points", (long)points.size());
+
+    // Register the faces once, and again only if the removed faces
+    // dominate the face array.
+    if (!mConflictFacesRegistered ||
+        mConflictLists.numFacesRemoved() > mConflictLists.numFaces() / 2) {
+        registerConflictFaces();
+    }
+
+    const long first = mConflictLists.numPoints();
+
+    {
+        HullTimer timer(
+            mHullStats.mPhaseSeconds[HullStats::PHASE_INITIAL_CONFLICTS],
+            mHullStatsEnabled);
+
+        if (mInsertionOrder == INSERTION_ORDER_SHUFFLED) {
+            vector<Vec3> pointsShuffled (points);
+            vector<long> indicesShuffled(indices);
+            shufflePoints(pointsShuffled, indicesShuffled);
+            addConflictPointsByWalk(pointsShuffled, indicesShuffled);
+        }
+        else {
+            addConflictPointsByWalk(points, indices);
+        }
+    }
+
+    MAKENA_LOG(INFO, "%ld points outside of the hull",
+               mConflictLists.numPoints() - first);
+
+    insertConflictPoints(first);
+
+    // All the points are processed. Keep the faces for the next call.
+    mConflictLists.clearPoints();
+
+    setNormalsForVerticesAndEdges();
+
+    constructHelperMaps();
+}
+
+
+long Manifold::cullInteriorPoints(
+    vector<Vec3>&           points,
+    const size_t            index1,
+    const size_t            index2,
+    const size_t            index3,
+    const size_t            index4,
+    vector<unsigned char>&  culled
+) {
+    const long numDirs =
+                 (mInteriorCulling == INTERIOR_CULLING_14DOP) ? 7 : 3;
+    const Vec3 dirs[7] = { Vec3( 1.0,  0.0,  0.0),
+                           Vec3( 0.0,  1.0,  0.0),
+                           Vec3( 0.0,  0.0,  1.0),
+                           Vec3( 1.0,  1.0,  1.0),
+                           Vec3( 1.0,  1.0, -1.0),
+                           Vec3( 1.0, -1.0,  1.0),
+                           Vec3(-1.0,  1.0,  1.0)  };
+
+    // Find the extremal points along +-dirs in one pass.
+    size_t minIndices[7];
+    size_t maxIndices[7];
+    double minDots[7];
+    double maxDots[7];
+    for (long k = 0; k < numDirs; k++) {
+        minIndices[k] = 0;
+        maxIndices[k] = 0;
+        minDots[k]    = dirs[k].dot(points[0]);
+        maxDots[k]    = minDots[k];
+    }
+
+    for (size_t i = 1; i < points.size(); i++) {
+        auto& p = points[i];
+        for (long k = 0; k < numDirs; k++) {
+            auto dot = dirs[k].dot(p);
+            if (minDots[k] > dot) {
+                minDots[k]    = dot;
+                minIndices[k] = i;
+            }
+            if (maxDots[k] < dot) {
+                maxDots[k]    = dot;
+                maxIndices[k] = i;
+            }
+        }
+    }
+
+    auto& extremalPoints = mWorkExtremalPoints;
+    extremalPoints.clear();
+    extremalPoints.push_back(points[index1]);
+    extremalPoints.push_back(points[index2]);
+    extremalPoints.push_back(points[index3]);
+    extremalPoints.push_back(points[index4]);
+    for (long k = 0; k < numDirs; k++) {
+        extremalPoints.push_back(points[minIndices[k]]);
+        extremalPoints.push_back(points[maxIndices[k]]);
+    }
+
+    // Convex hull of the extremal points. The polytope is kept with its
+    // workspace, and it is freed by releaseWorkspace().
+    if (!mCullingPolytope) {
+        mCullingPolytope = make_unique<Manifold>(mLogStream);
+        mCullingPolytope->setInteriorCulling(INTERIOR_CULLING_NONE);
+        mCullingPolytope->setInsertionOrder(INSERTION_ORDER_INPUT);
+        mCullingPolytope->setWorkspaceMode(WORKSPACE_RETAIN);
+    }
+    auto&          polytope = *mCullingPolytope;
+    enum predicate pred;
+    polytope.clear();
+    polytope.findConvexHull(extremalPoints, pred, mEpsilonCHMargin);
+    if (pred != NONE) {
+        return 0;
+    }
+
+    // The planes in flat arrays: n.p <= d for the inside.
+    const long numPlanes = polytope.mFaces.size();
+    mWorkPlanes.resize(numPlanes * 4);
+    double* nx = mWorkPlanes.data();
+    double* ny = nx + numPlanes;
+    double* nz = ny + numPlanes;
+    double* nd = nz + numPlanes;
+    long    fIndex = 0;
+    auto fPair = polytope.faces();
+    for (auto fit = fPair.first; fit != fPair.second; fit++, fIndex++) {
+        auto  n   = (*fit)->nLCS();
+        auto  he  = *((*fit)->halfEdges().begin());
+        auto& p   = (*((*he)->src()))->pLCS();
+        nx[fIndex] = n.x();
+        ny[fIndex] = n.y();
+        nz[fIndex] = n.z();
+        nd[fIndex] = n.dot(p);
+    }
+
+    // Points within the margin from a plane are kept.
+    double scale = 1.0;
+    for (long k = 0; k < 3; k++) {
+        scale = std::max(scale, fabs(minDots[k]));
+        scale = std::max(scale, fabs(maxDots[k]));
+    }
+    const double margin    = EPSILON_LINEAR * scale;
+
+    long numCulled = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        const double x = points[i].x();
+        const double y = points[i].y();
+        const double z = points[i].z();
+        double maxDist = -1.0e300;
+        for (long j = 0; j < numPlanes; j++) {
+            const double dist = nx[j]*x + ny[j]*y + nz[j]*z - nd[j];
+            maxDist = std::max(maxDist, dist);
+        }
+        culled[i] = (maxDist < -margin) ? 1 : 0;
+        numCulled += culled[i];
+    }
+
+    return numCulled;
+}
+
+
+void Manifold::shufflePoints(
+    vector<Vec3>&   points,
+    vector<long>&   indices
+) {
+    std::mt19937_64 engine(mInsertionSeed);
+
+    for (long i = (long)points.size() - 1; i > 0; i--) {
+
+        // std::uniform_int_distribution is implementation-defined.
+        long j = (long)(engine() % (unsigned long long)(i + 1));
+        std::swap(points [i], points [j]);
+        std::swap(indices[i], indices[j]);
+    }
+}
+
+
+void Manifold::insertPointsByConflictGraph(
+    vector<Vec3>&   points,
+    vector<long>&   indices
+) {
     // For each face find conflicts.
     vector<Undirected::node_list_it_t> vertices;
 
-    createInitialConflictGraph(pointsReduced, indicesReduced, vertices);
+    createInitialConflictGraph(points, indices, vertices);
 
     logConflictGraph(INFO, __FILE__, __LINE__);
 
@@ -150,7 +734,7 @@ void Manifold::findConvexHull(
 
         auto& vc = dynamic_cast<VertexConflict&>(*(*vcit));
 
-        log(INFO, __FILE__, __LINE__, "Start of loop.");
+        MAKENA_LOG(INFO, "Start of loop.");
         logVertexConflict(INFO, __FILE__, __LINE__, vc);
 
         if (vc.degreeIn() > 0) {
@@ -177,18 +761,179 @@ void Manifold::findConvexHull(
 
         mConflictGraph.removeNode(vc);
 
-        log(INFO, __FILE__, __LINE__, "End of loop");
+        MAKENA_LOG(INFO, "End of loop");
         logContents(INFO, __FILE__, __LINE__);
         logConflictGraph(INFO, __FILE__, __LINE__);
     }
+}
 
-    // Tidy up
-    clearConflictGraph();
 
-    setNormalsForVerticesAndEdges();
+void Manifold::insertPointsByConflictLists(
+    vector<Vec3>&   points,
+    vector<long>&   indices
+) {
+    createInitialConflictLists(points, indices);
 
-    constructHelperMaps();
+    logConflictGraph(INFO, __FILE__, __LINE__);
+
+    insertConflictPoints(0);
+}
+
+
+void Manifold::insertConflictPoints(const long first)
+{
+    for (long i = first; i < mConflictLists.numPoints(); i++) {
+        insertConflictPoint(i);
+    }
+}
+
+
+void Manifold::insertConflictPoint(const long i)
+{
+    MAKENA_LOG(INFO, "Start of loop.");
+    logVertexConflict(INFO, __FILE__, __LINE__, i);
+
+    if (!mConflictLists.faces(i).empty()) {
+
+        auto& conflictFaces = mWorkConflictFaces;
+        conflictFaces.clear();
+
+        auto abort = findVisibleFaces(i, conflictFaces);
+
+        if (!abort) {
+
+            auto& frontier = mWorkFrontier;
+
+            auto vp = updateFaces(
+                          mConflictLists.p(i), mConflictLists.id(i),
+                          conflictFaces, frontier, abort              );
+            if (!abort) {
+
+                updateConflictGraph(frontier);
+
+                checkAndMergeFacesCounterClockwise(vp);
+            }
+        }
+    }
+
+    mConflictLists.removePoint(i);
+
+    MAKENA_LOG(INFO, "End of loop");
+    logContents(INFO, __FILE__, __LINE__);
+    logConflictGraph(INFO, __FILE__, __LINE__);
+}
+
+
+void Manifold::insertPointsFarthestFirst(
+    vector<Vec3>&   points,
+    vector<long>&   indices
+) {
+    createInitialConflictLists(points, indices);
+
+    logConflictGraph(INFO, __FILE__, __LINE__);
+
+    std::priority_queue<pair<double, long>> Q;
+    for (long i = 0; i < mConflictLists.numPoints(); i++) {
+        Q.emplace(distanceToConflictFaces(i), i);
+    }
+
+    while (!Q.empty()) {
+
+        const long i = Q.top().second;
+        Q.pop();
+
+        if (mConflictLists.isPointRemoved(i)) {
+            continue;
+        }
+        if (mConflictLists.faces(i).empty()) {
+            // Inside of the current hull.
+            mConflictLists.removePoint(i);
+            continue;
+        }
+
+        // The key is stale if the faces it saw have been replaced.
+        const double dist = distanceToConflictFaces(i);
+        if (!Q.empty() && dist < Q.top().first) {
+            Q.emplace(dist, i);
+            continue;
+        }
+
+        if (dist <= mHullTolerance || isHullBudgetReached()) {
+            break;
+        }
+
+        insertConflictPoint(i);
+    }
+
+    // The points still in mConflictLists are outside of the hull.
+    mApproximationError = 0.0;
+    for (long i = 0; i < mConflictLists.numPoints(); i++) {
+        if (!mConflictLists.isPointRemoved(i)) {
+            mApproximationError = std::max(
+                             mApproximationError, distanceToConflictFaces(i));
+        }
+    }
+
+    MAKENA_LOG(INFO,
+        "Approximate hull: %ld vertices, %ld faces, error %f",
+        (long)mVertices.size(), (long)mFaces.size(), mApproximationError);
+
+    if (mHullApproximation == HULL_APPROXIMATION_EXPANDED &&
+        mApproximationError > 0.0                             ) {
+        expandHullToConflictPoints();
+    }
+}
 
+
+double Manifold::distanceToConflictFaces(const long pointIndex)
+{
+    auto&  p       = mConflictLists.p(pointIndex);
+    double maxDist = 0.0;
+
+    for (auto fIndex : mConflictLists.faces(pointIndex)) {
+        auto  fit  = mConflictLists.face(fIndex);
+        auto  he   = *((*fit)->halfEdges().begin());
+        auto& pSrc = (*((*he)->src()))->pLCS();
+        maxDist    = std::max(maxDist, (*fit)->nLCS().dot(p - pSrc));
+    }
+    return maxDist;
+}
+
+
+void Manifold::expandHullToConflictPoints()
+{
+    Vec3 center(0.0, 0.0, 0.0);
+    for (auto& v : mVertices) {
+        center += v->pLCS();
+    }
+    center.scale(1.0 / mVertices.size());
+
+    // A point p outside of the plane n.x = d is enclosed if the plane is
+    // moved away from the center by (n.p - n.c) / (d - n.c).
+    double scale = 1.0;
+    for (long i = 0; i < mConflictLists.numPoints(); i++) {
+        if (mConflictLists.isPointRemoved(i)) {
+            continue;
+        }
+        auto& p = mConflictLists.p(i);
+        for (auto fIndex : mConflictLists.faces(i)) {
+            auto  fit    = mConflictLists.face(fIndex);
+            auto  he     = *((*fit)->halfEdges().begin());
+            auto& pSrc   = (*((*he)->src()))->pLCS();
+            auto& n      = (*fit)->nLCS();
+            auto  height = n.dot(pSrc - center);
+            if (height > mEpsilonCHMargin) {
+                scale = std::max(scale, n.dot(p - center) / height);
+            }
+        }
+    }
+
+    for (auto& v : mVertices) {
+        v->mPointLCS = center + (v->mPointLCS - center) * scale;
+    }
+    mApproximationScale = scale;
+
+    MAKENA_LOG(INFO, "Hull expanded by %f", scale);
 }
 
 
@@ -288,7 +1033,7 @@ enum predicate Manifold::analyzePoints(
 
     if (!yAbsMaxFound) {
         // Ill-shaped. All the points are coincident to either xMin or xMax.
-        log(WARNING, __FILE__, __LINE__, "All points on an edge.");
+        MAKENA_LOG(WARNING, "All points on an edge.");
         return MAYBE_COLINEAR;
     }
 
@@ -307,98 +1052,434 @@ enum predicate Manifold::analyzePoints(
             auto v2 = p - p2;
             auto v3 = p - p3;
 
-            if ( v1.squaredNorm2() < EPSILON_SQUARED || 
-                 v2.squaredNorm2() < EPSILON_SQUARED ||
-                 v3.squaredNorm2() < EPSILON_SQUARED   ) {
-                continue;
+            if ( v1.squaredNorm2() < EPSILON_SQUARED || 
+                 v2.squaredNorm2() < EPSILON_SQUARED ||
+                 v3.squaredNorm2() < EPSILON_SQUARED   ) {
+                continue;
+            }
+
+            double dot = fabs(ax3.dot(v1));
+            if (!zAbsMaxFound) {
+                zAbsMaxFound = true;
+                zAbsMax      = dot;
+                zAbsMaxIndex = i;
+            }
+            else if (dot > zAbsMax) {
+                zAbsMax      = dot;
+                zAbsMaxIndex = i;
+            }
+        }
+    }
+
+    if (!zAbsMaxFound) {
+        // Ill-shaped. All the points are coincident to xMin, xMax or yAbsMax.
+        MAKENA_LOG(WARNING, "All points on a plane.");
+        return MAYBE_COPLANAR;
+    }
+
+    index1 = xMinIndex;
+    index2 = xMaxIndex;
+    index3 = yAbsMaxIndex;
+    index4 = zAbsMaxIndex; 
+
+    return NONE;
+}
+
+
+/** @brief subroutine for findConvexHull()
+ *
+ *         creates the initial bi-partite conflict graph between the faces
+ *         of the initial 3-simplex and the given points for the convex
+ *         hull finding algorithm. The graph is created into
+ *         mConflictGraph.
+ *
+ *  @param  points   (in):  the set of points in LCS.
+ *
+ *  @param  vertices (out): set of vertices in the conflict graph that
+ *                          represents the given points.
+ */
+void Manifold::createInitialConflictGraph(
+    std::vector<Vec3>&                       points,
+    std::vector<long>&                       indices,
+    std::vector<Undirected::node_list_it_t>& vertices
+) {
+    HullTimer timer(
+        mHullStats.mPhaseSeconds[HullStats::PHASE_INITIAL_CONFLICTS],
+        mHullStatsEnabled);
+
+    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+        auto fcp = make_unique<FaceConflict>(fit);
+        auto& fc = mConflictGraph.addNode(std::move(fcp));
+        (*fit)->mFaceConflict = fc.backIt();
+
+    }
+
+    for (long i = 0; i < points.size(); i++) {
+        auto& p   = points[i];
+        auto& id  = indices[i];
+        auto vcit = mConflictGraph.nodes().second;
+
+        for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+
+            auto& fcit = (*fit)->mFaceConflict;
+            auto& fc   = dynamic_cast<FaceConflict&>(*(*fcit));
+
+            enum predicate pred;
+            if (isFaceFacing(fit, p, pred)) {
+                if (pred == NONE) {
+                    if (vcit == mConflictGraph.nodes().second) {
+                        auto vcp = make_unique<VertexConflict>(p, id);
+                        vcit = mConflictGraph.addNode(std::move(vcp)).backIt();
+                        vertices.push_back(vcit);
+                    }
+
+                    auto& vc = dynamic_cast<VertexConflict&>(*(*vcit));
+                    auto  ep = make_unique<Directed::DiEdge>();
+                    mConflictGraph.addEdge(std::move(ep), fc, vc);
+                    mHullStats.mNumConflictsCreated++;
+                }
+            }
+        }
+    }
+}
+
+
+/** @brief subroutine for findConvexHull()
+ *
+ *         CONFLICT_LISTS version of createInitialConflictGraph().
+ *         As in the conflict graph, only the points that see at least one
+ *         face are added to mConflictLists in the given order.
+ */
+void Manifold::createInitialConflictLists(
+    std::vector<Vec3>&                       points,
+    std::vector<long>&                       indices
+) {
+    HullTimer timer(
+        mHullStats.mPhaseSeconds[HullStats::PHASE_INITIAL_CONFLICTS],
+        mHullStatsEnabled);
+
+    mConflictLists.clear();
+
+    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+        (*fit)->mConflictIndex = mConflictLists.addFace(fit);
+    }
+
+    addConflictPoints(points, indices);
+}
+
+
+void Manifold::registerConflictFaces()
+{
+    mConflictLists.clear();
+
+    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+        (*fit)->mConflictIndex = mConflictLists.addFace(fit);
+    }
+
+    mConflictFacesRegistered = true;
+
+    Vec3 center(0.0, 0.0, 0.0);
+    for (auto& v : mVertices) {
+        center += v->pLCS();
+    }
+    center.scale(1.0 / mVertices.size());
+    mConflictCenter = center;
+
+    // The walk needs the center strictly behind all the faces.
+    mConflictWalkEnabled = true;
+    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+        auto  he   = *((*fit)->halfEdges().begin());
+        auto& pSrc = (*((*he)->src()))->pLCS();
+        if ((*fit)->nLCS().dot(pSrc - center) <= mEpsilonCHMargin) {
+            mConflictWalkEnabled = false;
+            break;
+        }
+    }
+}
+
+
+void Manifold::addConflictPoints(
+    std::vector<Vec3>&                       points,
+    std::vector<long>&                       indices
+) {
+    const bool exact = (mPredicateMode != PREDICATES_EPSILON);
+
+    // The inner arrays of the work space are reused.
+    auto& faceVertices = mWorkFaceVertices;
+    if (faceVertices.size() < mFaces.size()) {
+        faceVertices.resize(mFaces.size());
+    }
+    long i = 0;
+    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++, i++) {
+        auto& vertices = faceVertices[i];
+        if (exact) {
+            vertices.resize(3);
+            getFacePlanePoints(fit, vertices[0], vertices[1], vertices[2]);
+        }
+        else {
+            getFaceVertexPoints(fit, vertices);
+        }
+    }
+
+    double xs[POINT_BLOCK_SIZE];
+    double ys[POINT_BLOCK_SIZE];
+    double zs[POINT_BLOCK_SIZE];
+    auto&  facingMasks = mWorkFacingMasks;
+    facingMasks.resize(mFaces.size());
+
+    for (long begin = 0; begin < points.size(); begin += POINT_BLOCK_SIZE) {
+
+        const long num = std::min(POINT_BLOCK_SIZE, (long)points.size()-begin);
+        for (long j = 0; j < num; j++) {
+            xs[j] = points[begin + j].x();
+            ys[j] = points[begin + j].y();
+            zs[j] = points[begin + j].z();
+        }
+
+        long k = 0;
+        for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++, k++) {
+            uint64_t coplanar, behind;
+            if (exact) {
+                auto& v = faceVertices[k];
+                orientBlockToPlane(v[0], v[1], v[2], xs, ys, zs, num,
+                                   facingMasks[k], coplanar);
+            }
+            else {
+                classifyPointBlock(xs, ys, zs, num, faceVertices[k],
+                                   (*fit)->nLCS(), mEpsilonCHMargin,
+                                   facingMasks[k], coplanar, behind);
+            }
+        }
+
+        for (long j = 0; j < num; j++) {
+            long pIndex = -1;
+            long k      = 0;
+            for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++, k++) {
+                if ((facingMasks[k] >> j) & 1ULL) {
+                    if (pIndex == -1) {
+                        pIndex = mConflictLists.addPoint(
+                                          points[begin + j], indices[begin + j]);
+                    }
+                    mConflictLists.addConflict((*fit)->mConflictIndex, pIndex);
+                    mHullStats.mNumConflictsCreated++;
+                }
+            }
+        }
+    }
+}
+
+
+void Manifold::addConflictPointsByWalk(
+    std::vector<Vec3>&                       points,
+    std::vector<long>&                       indices
+) {
+    if (!mConflictWalkEnabled) {
+        addConflictPoints(points, indices);
+        return;
+    }
+
+    auto& marks  = mWorkFaceMarks;
+    auto& region = mWorkFaceRegion;
+    marks.assign(mConflictLists.numFaces(), 0);
+
+    auto& c     = mConflictCenter;
+    auto  start = mFaces.begin();
+
+    for (long i = 0; i < points.size(); i++) {
+
+        auto& p = points[i];
+        Vec3  d = p - c;
+
+        // Hill-climb to the face that maximizes n.d / n.(s - c).
+        auto   fit   = start;
+        auto   he0   = *((*fit)->halfEdges().begin());
+        double h     = (*fit)->nLCS().dot((*((*he0)->src()))->pLCS() - c);
+        bool   valid = (h > 0.0);
+        double g     = valid ? ((*fit)->nLCS().dot(d) / h) : 0.0;
+        bool   moved = true;
+        while (moved && valid) {
+            moved = false;
+            for (auto heit : (*fit)->halfEdges()) {
+                auto  fAdj = (*((*heit)->buddy()))->face();
+                auto  he   = *((*fAdj)->halfEdges().begin());
+                auto& n    = (*fAdj)->nLCS();
+                auto  hAdj = n.dot((*((*he)->src()))->pLCS() - c);
+                if (hAdj <= 0.0) {
+                    valid = false;
+                    break;
+                }
+                auto  gAdj = n.dot(d) / hAdj;
+                if (g < gAdj) {
+                    fit   = fAdj;
+                    g     = gAdj;
+                    moved = true;
+                    break;
+                }
+            }
+        }
+
+        if (!valid) {
+            // The hull has become too thin around c. Test all the faces.
+            long pIndex = -1;
+            for (auto fAll = mFaces.begin(); fAll != mFaces.end(); fAll++) {
+                enum predicate pred;
+                if (isFaceFacing(fAll, p, pred) && pred == NONE) {
+                    if (pIndex == -1) {
+                        pIndex = mConflictLists.addPoint(p, indices[i]);
+                    }
+                    mConflictLists.addConflict(
+                                           (*fAll)->mConflictIndex, pIndex);
+                    mHullStats.mNumConflictsCreated++;
+                }
             }
+            continue;
+        }
 
-            double dot = fabs(ax3.dot(v1));
-            if (!zAbsMaxFound) {
-                zAbsMaxFound = true;
-                zAbsMax      = dot;
-                zAbsMaxIndex = i;
+        start = fit;
+        if (g <= 1.0) {
+            // The ray from c to p leaves the hull beyond p.
+            continue;
+        }
+
+        // Collect the faces around fit whose planes are not far behind p.
+        // They include all the faces p can see.
+        region.clear();
+        region.push_back(fit);
+        marks[(*fit)->mConflictIndex] = 1;
+        for (long k = 0; k < region.size(); k++) {
+            for (auto heit : (*(region[k]))->halfEdges()) {
+                auto fAdj = (*((*heit)->buddy()))->face();
+                auto& mark = marks[(*fAdj)->mConflictIndex];
+                if (mark != 0) {
+                    continue;
+                }
+                mark = 1;
+                double distMax = -mEpsilonCHMargin;
+                for (auto heit2 : (*fAdj)->halfEdges()) {
+                    auto& q = (*((*heit2)->src()))->pLCS();
+                    distMax = std::max(distMax, (*fAdj)->nLCS().dot(p - q));
+                }
+                if (distMax > -mEpsilonCHMargin) {
+                    region.push_back(fAdj);
+                }
             }
-            else if (dot > zAbsMax) {
-                zAbsMax      = dot;
-                zAbsMaxIndex = i;
+        }
+
+        long pIndex = -1;
+        for (auto& fRegion : region) {
+            enum predicate pred;
+            if (isFaceFacing(fRegion, p, pred) && pred == NONE) {
+                if (pIndex == -1) {
+                    pIndex = mConflictLists.addPoint(p, indices[i]);
+                }
+                mConflictLists.addConflict(
+                                       (*fRegion)->mConflictIndex, pIndex);
+                mHullStats.mNumConflictsCreated++;
             }
         }
-    }
 
-    if (!zAbsMaxFound) {
-        // Ill-shaped. All the points are coincident to xMin, xMax or yAbsMax.
-        log(WARNING, __FILE__, __LINE__, "All points on a plane.");
-        return MAYBE_COPLANAR;
+        // Reset the marks of the region and its boundary.
+        for (auto& fRegion : region) {
+            marks[(*fRegion)->mConflictIndex] = 0;
+            for (auto heit : (*fRegion)->halfEdges()) {
+                marks[(*((*((*heit)->buddy()))->face()))->mConflictIndex] = 0;
+            }
+        }
     }
+}
 
-    index1 = xMinIndex;
-    index2 = xMaxIndex;
-    index3 = yAbsMaxIndex;
-    index4 = zAbsMaxIndex; 
 
-    return NONE;
+void Manifold::getFaceVertexPoints(const FaceIt& fit, vector<Vec3>& vertices)
+{
+    vertices.clear();
+    for (auto heit : (*fit)->halfEdges()) {
+        vertices.push_back((*((*heit)->src()))->pLCS());
+    }
 }
 
 
-/** @brief subroutine for findConvexHull()
- *
- *         creates the initial bi-partite conflict graph between the faces
- *         of the initial 3-simplex and the given points for the convex
- *         hull finding algorithm. The graph is created into
- *         mConflictGraph.
- *
- *  @param  points   (in):  the set of points in LCS.
- *
- *  @param  vertices (out): set of vertices in the conflict graph that
- *                          represents the given points.
- */
-void Manifold::createInitialConflictGraph(
-    std::vector<Vec3>&                       points,
-    std::vector<long>&                       indices,
-    std::vector<Undirected::node_list_it_t>& vertices
+void Manifold::addConflictsForFace(
+    const FaceIt&        fit,
+    const long*          pointIndices,
+    const long           numPoints
 ) {
+    const auto fIndex = (*fit)->mConflictIndex;
+    const bool exact  = (mPredicateMode != PREDICATES_EPSILON);
 
-    for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
-        auto fcp = make_unique<FaceConflict>(fit);
-        auto& fc = mConflictGraph.addNode(std::move(fcp));
-        (*fit)->mFaceConflict = fc.backIt();
-
+    Vec3 a, b, c;
+    if (exact) {
+        getFacePlanePoints(fit, a, b, c);
+    }
+    else {
+        getFaceVertexPoints(fit, mFaceVertexPoints);
     }
 
-    for (long i = 0; i < points.size(); i++) {
-        auto& p   = points[i];
-        auto& id  = indices[i];
-        auto vcit = mConflictGraph.nodes().second;
+    double xs[POINT_BLOCK_SIZE];
+    double ys[POINT_BLOCK_SIZE];
+    double zs[POINT_BLOCK_SIZE];
 
-        for (auto fit =  mFaces.begin(); fit != mFaces.end(); fit++) {
+    for (long begin = 0; begin < numPoints; begin += POINT_BLOCK_SIZE) {
 
-            auto& fcit = (*fit)->mFaceConflict;
-            auto& fc   = dynamic_cast<FaceConflict&>(*(*fcit));
+        const long num = std::min(POINT_BLOCK_SIZE, numPoints - begin);
+        for (long j = 0; j < num; j++) {
+            auto& p = mConflictLists.p(pointIndices[begin + j]);
+            xs[j] = p.x();
+            ys[j] = p.y();
+            zs[j] = p.z();
+        }
 
-            enum predicate pred;
-            if ((*fit)->isFacing(p, pred, mEpsilonCHMargin)) {
-                if (pred == NONE) {
-                    if (vcit == mConflictGraph.nodes().second) {
-                        auto vcp = make_unique<VertexConflict>(p, id);
-                        vcit = mConflictGraph.addNode(std::move(vcp)).backIt();
-                        vertices.push_back(vcit);
-                    }
+        uint64_t facing, coplanar, behind;
+        if (exact) {
+            orientBlockToPlane(a, b, c, xs, ys, zs, num, facing, coplanar);
+        }
+        else {
+            classifyPointBlock(xs, ys, zs, num, mFaceVertexPoints,
+                  (*fit)->nLCS(), mEpsilonCHMargin, facing, coplanar, behind);
+        }
 
-                    auto& vc = dynamic_cast<VertexConflict&>(*(*vcit));
-                    auto  ep = make_unique<Directed::DiEdge>();
-                    mConflictGraph.addEdge(std::move(ep), fc, vc);
-                }
+        for (long j = 0; j < num; j++) {
+            if ((facing >> j) & 1ULL) {
+                mConflictLists.addConflict(fIndex, pointIndices[begin + j]);
+                mHullStats.mNumConflictsCreated++;
             }
         }
     }
 }
 
 
+bool Manifold::findVisibleFaces(
+    const long      pointIndex,
+    vector<FaceIt>& conflictFaces
+) {
+    HullTimer timer(mHullStats.mPhaseSeconds[HullStats::PHASE_VISIBLE_FACES],
+                    mHullStatsEnabled);
+
+    bool abort = false;
+
+    for (auto fIndex : mConflictLists.faces(pointIndex)) {
+
+        auto fit = mConflictLists.face(fIndex);
+
+        if (vertexIsTooCloseToFace(mConflictLists.p(pointIndex), fit)) {
+            MAKENA_LOG(INFO,
+                "Aborting. Point is too close to face [%d]", (*fit)->id());
+            mHullStats.mNumInsertionAborts++;
+            abort = true;
+            break;
+        }
+        conflictFaces.push_back(fit);
+    }
+    return abort;
+}
+
+
 bool Manifold::findVisibleFaces(
     VertexConflict& vc,
     vector<FaceIt>& conflictFaces
 ) {
+    HullTimer timer(mHullStats.mPhaseSeconds[HullStats::PHASE_VISIBLE_FACES],
+                    mHullStatsEnabled);
+
     auto iPair = vc.incidentEdgesIn();
 
     bool abort = false;
@@ -410,9 +1491,10 @@ bool Manifold::findVisibleFaces(
         auto& fc = dynamic_cast<FaceConflict&>(e.adjacentNode(vc));
 
         if (vertexIsTooCloseToFace(vc.p(), fc.face())) {
-            log(INFO, __FILE__, __LINE__,
+            MAKENA_LOG(INFO,
                 "Aborting. Point is too close to face [%d]",
                 (*(fc.face()))->id()                         );
+            mHullStats.mNumInsertionAborts++;
             abort = true;
             break;
         }
@@ -422,8 +1504,106 @@ bool Manifold::findVisibleFaces(
 }
 
 
+void Manifold::getFacePlanePoints(
+    const FaceIt& fit,
+    Vec3&         a,
+    Vec3&         b,
+    Vec3&         c
+) {
+    auto& halfEdges = (*fit)->halfEdges();
+    auto  heit      = halfEdges.begin();
+    a = (*((*(*heit))->src()))->pLCS();
+    b = (*((*(*heit))->dst()))->pLCS();
+    c = b;
+
+    const Vec3 ab      = b - a;
+    double     maxArea = -1.0;
+    for (heit++; heit != halfEdges.end(); heit++) {
+        auto& p    = (*((*(*heit))->dst()))->pLCS();
+        auto  area = ab.cross(p - a).squaredNorm2();
+        if (maxArea < area) {
+            maxArea = area;
+            c       = p;
+        }
+    }
+}
+
+
+bool Manifold::isFaceFacing(
+    const FaceIt&   fit,
+    const Vec3&     p,
+    enum predicate& pred
+) {
+    if (mPredicateMode == PREDICATES_EPSILON) {
+        return (*fit)->isFacing(p, pred, mEpsilonCHMargin);
+    }
+
+    Vec3 a, b, c;
+    getFacePlanePoints(fit, a, b, c);
+    const int orient = orientToPlane(a, b, c, p);
+    pred = (orient == 0) ? MAYBE_COPLANAR : NONE;
+    return orient > 0;
+}
+
+
+enum predicate Manifold::facesCoplanarity(const FaceIt& f1, const FaceIt& f2)
+{
+    if (mPredicateMode == PREDICATES_EPSILON) {
+        return (*f1)->isCoplanar(f2);
+    }
+
+    Vec3 a, b, c;
+    getFacePlanePoints(f1, a, b, c);
+    for (auto heit : (*f2)->halfEdges()) {
+        if (orientToPlane(a, b, c, (*((*heit)->src()))->pLCS()) != 0) {
+            return NONE;
+        }
+    }
+    return MAYBE_COPLANAR;
+}
+
+
+int Manifold::orientToPlane(
+    const Vec3& a,
+    const Vec3& b,
+    const Vec3& c,
+    const Vec3& p
+) {
+    if (mPredicateMode == PREDICATES_EXACT_INTEGER) {
+        return orient3dInteger(a, b, c, p);
+    }
+    return orient3d(a, b, c, p);
+}
+
+
+void Manifold::orientBlockToPlane(
+    const Vec3&    a,
+    const Vec3&    b,
+    const Vec3&    c,
+    const double*  xs,
+    const double*  ys,
+    const double*  zs,
+    const long     numPoints,
+    uint64_t&      positive,
+    uint64_t&      zero
+) {
+    if (mPredicateMode == PREDICATES_EXACT_INTEGER) {
+        orient3dIntegerBlock(a, b, c, xs, ys, zs, numPoints, positive, zero);
+    }
+    else {
+        orient3dBlock(a, b, c, xs, ys, zs, numPoints, positive, zero);
+    }
+}
+
+
 bool Manifold::vertexIsTooCloseToFace(const Vec3& pTest, FaceIt fit)
 {
+    if (mPredicateMode != PREDICATES_EPSILON) {
+        // The point is strictly in front of the plane of the face, and
+        // it can not be on any of its vertices or edges.
+        return false;
+    }
+
     for (auto& he : (*fit)->halfEdges()) {
 
         const Vec3   pSrc     = (*((*he)->src()))->pLCS();
@@ -432,7 +1612,7 @@ bool Manifold::vertexIsTooCloseToFace(const Vec3& pTest, FaceIt fit)
         const double sqDist   = pSrcTest.squaredNorm2();
 
         if (sqDist < mEpsilonCHMargin) {
-            log(INFO, __FILE__, __LINE__, 
+            MAKENA_LOG(INFO,
                          "Vertex too close to [%d]", (*((*he)->src()))->id());
             return true;
         }
@@ -449,7 +1629,7 @@ bool Manifold::vertexIsTooCloseToFace(const Vec3& pTest, FaceIt fit)
              (v12.dot(v1t)       > 0.0)                &&
              (v1t.squaredNorm2() < v12.squaredNorm2())    ) {
 
-            log(INFO, __FILE__, __LINE__, "Vertex too close to (%d,%d)", 
+            MAKENA_LOG(INFO, "Vertex too close to (%d,%d)",
                              (*((*he)->src()))->id(),(*((*he)->dst()))->id());
             return true;
         }
@@ -466,19 +1646,27 @@ VertexIt Manifold::updateFaces(
     vector<FrontierElem>& frontier,
     bool&                 abort
 ) {
-    vector<HalfEdgeIt> frontierHalfEdges
-                                    = findCircumference(conflictFaces, abort);
+    HullTimer timer(mHullStats.mPhaseSeconds[HullStats::PHASE_FAN_CREATION],
+                    mHullStatsEnabled);
+
+    auto& frontierHalfEdges = mWorkCircumference;
+    findCircumference(conflictFaces, frontierHalfEdges, abort);
     if (abort) {
-        log(INFO, __FILE__, __LINE__, "Aborting.");
+        MAKENA_LOG(INFO, "Aborting.");
+        mHullStats.mNumInsertionAborts++;
         return mVertices.end();
     }
 
     // Temporarily save the conflict graph info for the faces being deleted
     // to FrontierElems.
-    frontier = makeFrontier(frontierHalfEdges);
+    makeFrontier(frontierHalfEdges, frontier);
 
     for (auto& cf : conflictFaces) {
 
+        if (mConflictTrackingMode == CONFLICT_LISTS) {
+            mConflictLists.removeFace((*cf)->mConflictIndex);
+            continue;
+        }
         auto& fcit = (*cf)->mFaceConflict;
         auto& fc = dynamic_cast<FaceConflict&>(*(*fcit));
         mConflictGraph.removeNode(fc);
@@ -491,10 +1679,53 @@ VertexIt Manifold::updateFaces(
 }
 
 
-vector<FrontierElem> Manifold::makeFrontier(vector<HalfEdgeIt>& halfEdges)
-{
+void Manifold::makeFrontier(
+    vector<HalfEdgeIt>&   halfEdges,
+    vector<FrontierElem>& elements
+) {
+    elements.clear();
+
+    if (mConflictTrackingMode == CONFLICT_LISTS) {
+
+        auto& found  = mConflictLists.mPointFound;
+        auto& points = mWorkFrontierPoints;
+        points.clear();
+
+        for (auto& he : halfEdges) {
+
+            FrontierElem fe;
 
-    vector<FrontierElem> elements;
+            fe.mHeit              = he;
+            fe.mFacingPointsBegin = points.size();
+
+            auto  fIndex1 = (*((*he)->mFace))->mConflictIndex;
+            auto& points1 = mConflictLists.points(fIndex1);
+            for (auto pIndex : points1) {
+                if (!mConflictLists.isPointRemoved(pIndex)) {
+                    found[pIndex] = true;
+                    points.push_back(pIndex);
+                }
+            }
+
+            auto  fIndex2 = (*((*((*he)->mBuddy))->mFace))->mConflictIndex;
+            for (auto pIndex : mConflictLists.points(fIndex2)) {
+                if (!mConflictLists.isPointRemoved(pIndex) && !found[pIndex]){
+                    points.push_back(pIndex);
+                }
+            }
+
+            // Reset mPointFound.
+            for (auto pIndex : points1) {
+                found[pIndex] = false;
+            }
+
+            fe.mFacingPointsEnd = points.size();
+
+            elements.push_back(std::move(fe));
+        }
+
+        return;
+    }
 
     for (auto& he : halfEdges) {
 
@@ -541,13 +1772,28 @@ vector<FrontierElem> Manifold::makeFrontier(vector<HalfEdgeIt>& halfEdges)
         elements.push_back(std::move(fe));
 
     }
-
-    return elements;
 }
 
 
 void Manifold::updateConflictGraph(vector<FrontierElem>& frontier)
 {
+    HullTimer timer(mHullStats.mPhaseSeconds[HullStats::PHASE_CONFLICT_UPDATE],
+                    mHullStatsEnabled);
+
+    if (mConflictTrackingMode == CONFLICT_LISTS) {
+
+        for(auto& fe : frontier) {
+
+            auto& f = (*fe.mHeit)->mFace;
+
+            (*f)->mConflictIndex = mConflictLists.addFace(f);
+
+            addConflictsForFace(
+                f, mWorkFrontierPoints.data() + fe.mFacingPointsBegin,
+                fe.mFacingPointsEnd - fe.mFacingPointsBegin            );
+        }
+        return;
+    }
 
     for(auto& fe : frontier) {
 
@@ -562,12 +1808,13 @@ void Manifold::updateConflictGraph(vector<FrontierElem>& frontier)
 
             auto& vc = dynamic_cast<VertexConflict&>(*(*vcit));
             enum predicate pred;
-            if ((*f)->isFacing(vc.p(),pred,mEpsilonCHMargin)){
+            if (isFaceFacing(f, vc.p(), pred)){
 
                 if (pred == NONE) {
 
                     auto ep = make_unique<Directed::DiEdge>();
                     mConflictGraph.addEdge(std::move(ep), fc, vc);
+                    mHullStats.mNumConflictsCreated++;
 
                 }
             }
@@ -578,6 +1825,9 @@ void Manifold::updateConflictGraph(vector<FrontierElem>& frontier)
 
 void Manifold::checkAndMergeFacesCounterClockwise(VertexIt center)
 {
+    HullTimer timer(mHullStats.mPhaseSeconds[HullStats::PHASE_FACE_MERGES],
+                    mHullStatsEnabled);
+
     mEdgesToBeRemoved.clear();
     mVerticesToBeRemoved.clear();
 
@@ -618,8 +1868,9 @@ void Manifold::checkAndMergeFacesCounterClockwise(VertexIt center)
             if (abort) {
                 auto v1 = (*((*eit)->he1()))->src();
                 auto v2 = (*((*eit)->he1()))->dst();
-                log(INFO, __FILE__, __LINE__, "Edge removal aborted. (%d,%d)", 
-                                              (*v1)->id(),  (*v2)->id()      );
+                MAKENA_LOG(INFO, "Edge removal aborted. (%d,%d)",
+                                 (*v1)->id(),  (*v2)->id()        );
+                mHullStats.mNumMergeAborts++;
 
             }            
         }
@@ -659,6 +1910,14 @@ bool Manifold::areIncidentFacesParallelOrConcave(EdgeIt e)
     auto f1  = (*he1)->mFace;
     auto f2  = (*he2)->mFace;
 
+    if (mPredicateMode != PREDICATES_EPSILON) {
+        // The vertex of f2 next to the edge is not below the plane of f1.
+        Vec3 a, b, c;
+        getFacePlanePoints(f1, a, b, c);
+        auto& p = (*((*((*he2)->mNext))->dst()))->pLCS();
+        return orientToPlane(a, b, c, p) >= 0;
+    }
+
     const auto n1  = (*f1)->nLCS();
     const auto n2  = (*f2)->nLCS();
     const auto cr  = n1.cross(n2);
@@ -716,6 +1975,11 @@ bool Manifold::isNewFaceAreawiseConvex(
 
 void Manifold::mergeConsecutiveFaces(vector<FaceIt>& faces)
 {
+    if (mConflictTrackingMode == CONFLICT_LISTS) {
+        mergeConsecutiveFacesByConflictLists(faces);
+        return;
+    }
+
     vector<Wailea::Undirected::node_list_it_t> vertices;
 
     for (auto fit : faces) {
@@ -743,16 +2007,15 @@ void Manifold::mergeConsecutiveFaces(vector<FaceIt>& faces)
 
     bool abortIgnored;
     vector<HalfEdgeIt> halfEdges = findCircumference(faces, abortIgnored);
-    list<HalfEdgeIt>   halfEdgesList(halfEdges.begin(),halfEdges.end());
     removeFaces(faces);
 
-    auto fit = makePolygon(halfEdgesList);
+    auto fit = makePolygon(halfEdges.data(), halfEdges.size());
 
     for (auto heit : halfEdges) {
         auto fit    = (*heit)->face();
         auto hBuddy = (*heit)->mBuddy;
         auto fBuddy = (*hBuddy)->face();
-        (*((*heit)->mParent))->mPredFaces = (*fit)->isCoplanar(fBuddy);
+        (*((*heit)->mParent))->mPredFaces = facesCoplanarity(fit, fBuddy);
     }
 
     auto fcp = make_unique<FaceConflict>(fit);
@@ -763,13 +2026,55 @@ void Manifold::mergeConsecutiveFaces(vector<FaceIt>& faces)
 
         auto& VC = dynamic_cast<VertexConflict&>(*(*v));
         enum predicate pred;
-        if ((*fit)->isFacing(VC.p(), pred, mEpsilonCHMargin)) {
+        if (isFaceFacing(fit, VC.p(), pred)) {
             if (pred == NONE) {
                 auto  ep = make_unique<Directed::DiEdge>();
                 mConflictGraph.addEdge(std::move(ep), FC, VC);
+                mHullStats.mNumConflictsCreated++;
+            }
+        }
+    }
+}
+
+
+void Manifold::mergeConsecutiveFacesByConflictLists(vector<FaceIt>& faces)
+{
+    auto&        found = mConflictLists.mPointFound;
+    vector<long> points;
+
+    for (auto fit : faces) {
+
+        auto fIndex = (*fit)->mConflictIndex;
+        for (auto pIndex : mConflictLists.points(fIndex)) {
+            if (!mConflictLists.isPointRemoved(pIndex) && !found[pIndex]) {
+                found[pIndex] = true;
+                points.push_back(pIndex);
             }
         }
+        mConflictLists.removeFace(fIndex);
+    }
+
+    // Reset the flag.
+    for (auto pIndex : points) {
+        found[pIndex] = false;
+    }
+
+    bool abortIgnored;
+    vector<HalfEdgeIt> halfEdges = findCircumference(faces, abortIgnored);
+    removeFaces(faces);
+
+    auto fit = makePolygon(halfEdges.data(), halfEdges.size());
+
+    for (auto heit : halfEdges) {
+        auto fit    = (*heit)->face();
+        auto hBuddy = (*heit)->mBuddy;
+        auto fBuddy = (*hBuddy)->face();
+        (*((*heit)->mParent))->mPredFaces = facesCoplanarity(fit, fBuddy);
     }
+
+    (*fit)->mConflictIndex = mConflictLists.addFace(fit);
+
+    addConflictsForFace(fit, points.data(), points.size());
 }
 
 
@@ -795,10 +2100,21 @@ bool Manifold::checkForConcavity(
         auto p3     = (*v3)->pLCS();
         auto v12    = p2 - p1;
         auto v23    = p3 - p2;
-        v12.normalize();
-        v23.normalize();
-        auto cr     = v12.cross(v23);
-        if (n.dot(cr) < -1.0 * std::min(0.1, mEpsilonCHMargin*100.0)) {
+
+        bool dented;
+        if (mPredicateMode != PREDICATES_EPSILON) {
+            // The face is exactly planar, and any point off the plane on
+            // the side of the normal tells the turn at p2.
+            auto q = p2 + n * (v12.norm2() + v23.norm2());
+            dented = orient3d(p1, p2, p3, q) < 0;
+        }
+        else {
+            v12.normalize();
+            v23.normalize();
+            auto cr = v12.cross(v23);
+            dented  = n.dot(cr) < -1.0 * std::min(0.1, mEpsilonCHMargin*100.0);
+        }
+        if (dented) {
 
             // Concavity found
             auto e1      = (*he1)->mParent;
@@ -823,7 +2139,7 @@ bool Manifold::checkForConcavity(
                 for (auto fit : additionalFaces) {
                     (*fit)->mToBeMerged = false;
                 }
-                log(INFO, __FILE__, __LINE__, 
+                MAKENA_LOG(INFO,
                        "Edges dented but the adjacent face is not coplanar "
                        "Vertices: (%d -> %d -> %d), Faces: %d | (%d, %d)",
                        (*v1)->id(), (*v2)->id(), (*v3)->id(),
@@ -879,13 +2195,13 @@ bool Manifold::removeEdgeAndMergeFaces(EdgeIt eit)
 
         halfEdges = findCircumference(faces, abort);
         if (abort) {
-            log(INFO, __FILE__, __LINE__, "Aborting");
+            MAKENA_LOG(INFO, "Aborting");
             return true;
         }
         vector<FaceIt> newFaces;
         abort = checkForConcavity(halfEdges, newFaces);
         if (abort) {
-            log(INFO, __FILE__, __LINE__, "Aborting");
+            MAKENA_LOG(INFO, "Aborting");
             return true;
         }
         if (newFaces.empty()) {
@@ -896,6 +2212,7 @@ bool Manifold::removeEdgeAndMergeFaces(EdgeIt eit)
     findInnerEdgesAndRemoveFromChain(faces, halfEdges);
 
     mergeConsecutiveFaces(faces);
+    mHullStats.mNumFaceMerges++;
 
     for (auto he : halfEdges) {
         auto vit = (*he)->src();
@@ -967,7 +2284,7 @@ void Manifold::removeEdgeAndMergeFacesCheckForUpdate(VertexIt vit)
         }
         else if (degAdj == 4) {
             if (!(*vAdj)->mToBeRemoved) {
-                log(ERROR, __FILE__, __LINE__, 
+                MAKENA_LOG(ERROR,
                                 "Vertex not chained yet. [%d]", (*vAdj)->id());
             }
             // vAdj will become deg1 after removal.
@@ -1000,7 +2317,7 @@ void Manifold::removeEdgeAndMergeFacesCheckForUpdate(VertexIt vit)
             }
             else if (degAdj == 4) {
                 if (!(*vAdj)->mToBeRemoved) {
-                    log(ERROR, __FILE__, __LINE__, 
+                    MAKENA_LOG(ERROR,
                                 "Vertex not chained yet. [%d]", (*vAdj)->id());
                 }
                 // vAdj will become deg1 after removal.
@@ -1060,6 +2377,8 @@ void Manifold::removeVertexAndMergeEdges(VertexIt v2)
         return ;
     }
 
+    mHullStats.mNumVerticesRemoved++;
+
     // remove v2, he2, and he5.
     (*f2)->mIncidentHalfEdges.erase((*he5)->mFaceBackIt);
     (*f1)->mIncidentHalfEdges.erase((*he2)->mFaceBackIt);
@@ -1103,7 +2422,7 @@ void Manifold::removeVertexAndMergeEdges(VertexIt v2)
             (*eit1)->mToBeRemoved = true;
         }
         else {
-            log(ERROR, __FILE__, __LINE__, 
+            MAKENA_LOG(ERROR,
                     "Edge (%d, %d) already chained", (*v1)->id(), (*v3)->id());
         }
     }
@@ -1129,7 +2448,7 @@ void Manifold::removeVertexAndMergeEdges(VertexIt v2)
             (*eit1)->mToBeRemoved = true;
         }
         else {
-            log(ERROR, __FILE__, __LINE__, 
+            MAKENA_LOG(ERROR,
                     "Edge (%d, %d) already chained", (*v1)->id(), (*v3)->id());
         }
     }
@@ -1154,53 +2473,67 @@ void Manifold::clearConflictGraph()
 
         mConflictGraph.removeNode(N);
     }
+
+    mConflictLists.clear();
+    mConflictFacesRegistered = false;
 }
 
 
-void Manifold::logContents(
-    enum LogLevel lvl,
-    const char*   _file,
-    const int     _line
-) {
-    if (mLogLevel>0 && mLogLevel>=lvl) {
-
-        // Vertices
-        mLogStream << "Vertices\n";
-        for (auto& vit : mVertices) {
-            mLogStream << "    P: " << (vit)->id() << "\t";
-            mLogStream << (vit)->pLCS() << "\t";
-            mLogStream << "N: " << (vit)->nLCS() << "\n";
-
-        }
-
-        // Faces
-        mLogStream << "\nFaces\n";
-        for (auto& fit : mFaces) {
-            mLogStream << "    " << (fit)->id() << "\t";
-            mLogStream << "N: " << (fit)->nLCS() << "\t";
-            bool start = true;
-            for (auto& heit : (fit)->halfEdges()) {
-                if (start) {
-                    start = false;
-                }
-                else{
-                    mLogStream << " ";
-                }
-                mLogStream << (*((*heit)->mSrc))->id();
+void Manifold::writeContents()
+{
+    // Vertices
+    mLogStream << "Vertices\n";
+    for (auto& vit : mVertices) {
+        mLogStream << "    P: " << (vit)->id() << "\t";
+        mLogStream << (vit)->pLCS() << "\t";
+        mLogStream << "N: " << (vit)->nLCS() << "\n";
+
+    }
+
+    // Faces
+    mLogStream << "\nFaces\n";
+    for (auto& fit : mFaces) {
+        mLogStream << "    " << (fit)->id() << "\t";
+        mLogStream << "N: " << (fit)->nLCS() << "\t";
+        bool start = true;
+        for (auto& heit : (fit)->halfEdges()) {
+            if (start) {
+                start = false;
+            }
+            else{
+                mLogStream << " ";
             }
-            mLogStream << "\n";
+            mLogStream << (*((*heit)->mSrc))->id();
         }
-
+        mLogStream << "\n";
     }
 }
 
 
-void Manifold::logConflictGraph(
-    enum LogLevel lvl,
-    const char*   _file,
-    const int     _line
-) {
-    if (mLogLevel>0 && mLogLevel>=lvl) {
+void Manifold::writeConflictGraph()
+{
+    if (mConflictTrackingMode == CONFLICT_LISTS) {
+
+        mLogStream << "ConflictLists:\n";
+        mLogStream << "Points\n";
+        for (long i = 0; i < mConflictLists.numPoints(); i++) {
+            if (!mConflictLists.isPointRemoved(i)) {
+                mLogStream << "    P: " << mConflictLists.p(i) << "\t";
+                bool start = true;
+                for (auto fIndex : mConflictLists.faces(i)) {
+                    if (start) {
+                        start = false;
+                    }
+                    else{
+                        mLogStream << " ";
+                    }
+                    mLogStream << (*(mConflictLists.face(fIndex)))->id();
+                }
+                mLogStream << "\n";
+            }
+        }
+    }
+    else {
        
         mLogStream << "ConflictGraph:\n";
         mLogStream << "VertexConflicts\n";
@@ -1233,32 +2566,45 @@ void Manifold::logConflictGraph(
 }
 
 
-void Manifold::logVertexConflict(
-    enum LogLevel   lvl,
-    const char*     _file,
-    const int       _line,
-    VertexConflict& N
-) {
-    if (mLogLevel>0 && mLogLevel>=lvl) {
-        mLogStream << "VC: ";
-        mLogStream << N.p() << "\t";
-        mLogStream << N.id() << "\t";
-        bool start = true;
-        auto ePair = N.incidentEdgesIn();
-        for (auto eit = ePair.first; eit != ePair.second; eit++) {
-            auto& E  = dynamic_cast<Wailea::Directed::DiEdge&>(*(*(*eit)));
-            auto& F = dynamic_cast<FaceConflict&>(E.adjacentNode(N));
-            auto  fit = F.face();
-            if (start) {
-                start = false;
-            }
-            else{
-                mLogStream << " ";
-            }
-            mLogStream << (*fit)->id();
+void Manifold::writeVertexConflict(VertexConflict& N)
+{
+    mLogStream << "VC: ";
+    mLogStream << N.p() << "\t";
+    mLogStream << N.id() << "\t";
+    bool start = true;
+    auto ePair = N.incidentEdgesIn();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& E  = dynamic_cast<Wailea::Directed::DiEdge&>(*(*(*eit)));
+        auto& F = dynamic_cast<FaceConflict&>(E.adjacentNode(N));
+        auto  fit = F.face();
+        if (start) {
+            start = false;
         }
-        mLogStream << "\n";
+        else{
+            mLogStream << " ";
+        }
+        mLogStream << (*fit)->id();
+    }
+    mLogStream << "\n";
+}
+
+
+void Manifold::writeVertexConflict(const long pointIndex)
+{
+    mLogStream << "VC: ";
+    mLogStream << mConflictLists.p(pointIndex)  << "\t";
+    mLogStream << mConflictLists.id(pointIndex) << "\t";
+    bool start = true;
+    for (auto fIndex : mConflictLists.faces(pointIndex)) {
+        if (start) {
+            start = false;
+        }
+        else{
+            mLogStream << " ";
+        }
+        mLogStream << (*(mConflictLists.face(fIndex)))->id();
     }
+    mLogStream << "\n";
 }
 
 
@@ -1273,6 +2619,7 @@ static vector<FaceIt>                     debug_conflictFaces;
 static vector<HalfEdgeIt>                 debug_frontierHalfEdges;
 static vector<FrontierElem>               debug_frontier;
 static predicate                          debug_pred;
+static Manifold::ConflictTrackingMode    debug_savedConflictTrackingMode;
 
 // Set the points and find the initial 3-simplex.
 void Manifold::debugFindConvexHullStep1(vector<Vec3>& points)
@@ -1284,10 +2631,16 @@ void Manifold::debugFindConvexHullStep1(vector<Vec3>& points)
     debug_frontierHalfEdges.clear();
     debug_frontier.clear();
 
+    // The step-by-step processing works on the conflict graph until
+    // debugFindConvexHullTerm().
+    debug_savedConflictTrackingMode = mConflictTrackingMode;
+    mConflictTrackingMode           = CONFLICT_GRAPH;
+
     log(INFO, __FILE__, __LINE__, "findConvexHull() BEGIN");
 
     if (points.size() < 4) {
-        debug_pred = MAYBE_FLAT;
+        debug_pred            = MAYBE_FLAT;
+        mConflictTrackingMode = debug_savedConflictTrackingMode;
         return;
     }
 
@@ -1298,6 +2651,7 @@ void Manifold::debugFindConvexHullStep1(vector<Vec3>& points)
 
     debug_pred = analyzePoints(points, index1, index2, index3, index4);
     if (debug_pred != NONE) {
+        mConflictTrackingMode = debug_savedConflictTrackingMode;
         return;
     }
 
@@ -1427,7 +2781,7 @@ bool Manifold::debugFindConvexHullLoopStep2()
 
     //auto& vc = dynamic_cast<VertexConflict&>(*(*debug_vcit));
 
-    debug_frontier = makeFrontier(debug_frontierHalfEdges);
+    makeFrontier(debug_frontierHalfEdges, debug_frontier);
 
     for (auto& cf : debug_conflictFaces) {
 
@@ -1475,6 +2829,8 @@ void Manifold::debugFindConvexHullTerm()
     // Tidy up
     clearConflictGraph();
 
+    mConflictTrackingMode = debug_savedConflictTrackingMode;
+
     setNormalsForVerticesAndEdges();
 
     constructHelperMaps();
@@ -0,0 +1,90 @@
+#include "manifold.hpp"
+
+/**
+ * @file manifold_support.cpp
+ *
+ * @brief Support vertex queries on a convex manifold by hill-climbing
+ *        over the vertex adjacency.
+ *
+ *  @reference "Real-Time Collision Detection" C. Ericson
+ *             Morgan Kaufmann 2005, ISBN 1-55860-732-3, Section 9.5.4
+ */
+namespace Makena {
+
+using namespace std;
+
+
+VertexIt Manifold::findSupportVertex(const Vec3& direction, VertexIt start)
+{
+    if (mVertices.empty()) {
+        return mVertices.end();
+    }
+
+    mSupportStats.mNumQueries++;
+
+    VertexIt cur       = (start == mVertices.end()) ? mVertices.begin()
+                                                    : start;
+    double   curHeight = (*cur)->pLCS().dot(direction);
+    mSupportStats.mNumVerticesTested++;
+
+    // On a convex polytope, a vertex that is not lower than any of its
+    // adjacent vertices is the farthest. Only the strict increase is
+    // taken to guarantee the termination.
+    while (true) {
+
+        VertexIt bestVit    = cur;
+        double   bestHeight = curHeight;
+
+        for (auto heit : (*cur)->halfEdges()) {
+            auto& he = *(*heit);
+            if (he.mSrc != cur) {
+                continue;
+            }
+            const double h = (*(he.mDst))->pLCS().dot(direction);
+            mSupportStats.mNumVerticesTested++;
+            if (h > bestHeight) {
+                bestHeight = h;
+                bestVit    = he.mDst;
+            }
+        }
+
+        if (bestVit == cur) {
+            return cur;
+        }
+        cur       = bestVit;
+        curHeight = bestHeight;
+        mSupportStats.mNumSteps++;
+    }
+}
+
+
+VertexIt Manifold::findSupportVertex(const Vec3& direction)
+{
+    return findSupportVertex(direction, mVertices.end());
+}
+
+
+void Manifold::findSupportVertices(
+    const vector<Vec3>& directions,
+    vector<VertexIt>&   supports,
+    VertexIt            start
+) {
+    supports.resize(directions.size());
+
+    VertexIt cur = start;
+    for (size_t i = 0; i < directions.size(); i++) {
+        cur = findSupportVertex(directions[i], cur);
+        supports[i] = cur;
+    }
+}
+
+
+void Manifold::findSupportVertices(
+    const vector<Vec3>& directions,
+    vector<VertexIt>&   supports
+) {
+    findSupportVertices(directions, supports, mVertices.end());
+}
+
+
+}// namespace Makena
@@ -0,0 +1,160 @@
+#include "mass_properties.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file mass_properties.cpp
+ *
+ * @brief Finds the exact mass properties of the solid bounded by a closed
+ *        Manifold.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief the subexpressions of the integrals of a triangle for one axis.
+ *         w0, w1, and w2 are the coordinates of the vertices on the axis.
+ */
+static inline void triangleSubexpressions(
+    const double w0,
+    const double w1,
+    const double w2,
+    double&      f1,
+    double&      f2,
+    double&      f3,
+    double&      g0,
+    double&      g1,
+    double&      g2
+) {
+    const double temp0 = w0 + w1;
+    const double temp1 = w0 * w0;
+    const double temp2 = temp1 + w1 * temp0;
+
+    f1 = temp0 + w2;
+    f2 = temp2 + w2 * f1;
+    f3 = w0 * temp1 + w1 * temp2 + w2 * f2;
+    g0 = f2 + w0 * (f1 + w0);
+    g1 = f2 + w1 * (f1 + w1);
+    g2 = f2 + w2 * (f1 + w2);
+}
+
+
+void findMassProperties(
+    Manifold&    solid,
+    const double density,
+    double&      volume,
+    double&      surfaceArea,
+    double&      mass,
+    Vec3&        centerOfMass,
+    Mat3x3&      inertiaTensor
+) {
+    volume       = 0.0;
+    surfaceArea  = 0.0;
+    mass         = 0.0;
+    centerOfMass.zero();
+    inertiaTensor.zero();
+
+    auto vPair = solid.vertices();
+    if (vPair.first == vPair.second) {
+        return;
+    }
+
+    // The coordinates are taken relative to a vertex to reduce the
+    // cancellation for a solid far from the origin.
+    const Vec3 origin = (*vPair.first)->pLCS();
+
+    // The integrals of 1, x, y, z, x^2, y^2, z^2, xy, yz, and zx over the
+    // volume.
+    double integrals[10] = { 0.0, 0.0, 0.0, 0.0, 0.0,
+                             0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    auto fPair = solid.faces();
+    for (auto fit = fPair.first; fit != fPair.second; fit++) {
+
+        auto&      hes  = (*fit)->halfEdges();
+        auto       heit = hes.begin();
+        const Vec3 p0   = (*((**heit)->src()))->pLCS() - origin;
+        heit++;
+        if (heit == hes.end()) {
+            continue;
+        }
+        Vec3 p1 = (*((**heit)->src()))->pLCS() - origin;
+        heit++;
+
+        // The face is convex and triangulated as a fan.
+        for (; heit != hes.end(); heit++) {
+
+            const Vec3 p2 = (*((**heit)->src()))->pLCS() - origin;
+            const Vec3 d  = (p1 - p0).cross(p2 - p0);
+
+            surfaceArea += d.norm2() * 0.5;
+
+            double f1x, f2x, f3x, g0x, g1x, g2x;
+            double f1y, f2y, f3y, g0y, g1y, g2y;
+            double f1z, f2z, f3z, g0z, g1z, g2z;
+            triangleSubexpressions(p0.x(), p1.x(), p2.x(),
+                                   f1x, f2x, f3x, g0x, g1x, g2x);
+            triangleSubexpressions(p0.y(), p1.y(), p2.y(),
+                                   f1y, f2y, f3y, g0y, g1y, g2y);
+            triangleSubexpressions(p0.z(), p1.z(), p2.z(),
+                                   f1z, f2z, f3z, g0z, g1z, g2z);
+
+            integrals[0] += d.x() * f1x;
+            integrals[1] += d.x() * f2x;
+            integrals[2] += d.y() * f2y;
+            integrals[3] += d.z() * f2z;
+            integrals[4] += d.x() * f3x;
+            integrals[5] += d.y() * f3y;
+            integrals[6] += d.z() * f3z;
+            integrals[7] += d.x() * (p0.y() * g0x + p1.y() * g1x +
+                                     p2.y() * g2x                 );
+            integrals[8] += d.y() * (p0.z() * g0y + p1.z() * g1y +
+                                     p2.z() * g2y                 );
+            integrals[9] += d.z() * (p0.x() * g0z + p1.x() * g1z +
+                                     p2.x() * g2z                 );
+            p1 = p2;
+        }
+    }
+
+    integrals[0] /= 6.0;
+    for (size_t i = 1; i < 4; i++) {
+        integrals[i] /= 24.0;
+    }
+    for (size_t i = 4; i < 7; i++) {
+        integrals[i] /= 60.0;
+    }
+    for (size_t i = 7; i < 10; i++) {
+        integrals[i] /= 120.0;
+    }
+
+    volume = integrals[0];
+    mass   = volume * density;
+    if (volume <= 0.0) {
+        return;
+    }
+
+    const double cx = integrals[1] / volume;
+    const double cy = integrals[2] / volume;
+    const double cz = integrals[3] / volume;
+
+    // Moved to the center of mass by the parallel axis theorem.
+    const double ixx = integrals[5] + integrals[6] - volume * (cy*cy + cz*cz);
+    const double iyy = integrals[4] + integrals[6] - volume * (cz*cz + cx*cx);
+    const double izz = integrals[4] + integrals[5] - volume * (cx*cx + cy*cy);
+    const double ixy = -(integrals[7] - volume * cx * cy);
+    const double iyz = -(integrals[8] - volume * cy * cz);
+    const double izx = -(integrals[9] - volume * cz * cx);
+
+    centerOfMass  = origin + Vec3(cx, cy, cz);
+    inertiaTensor = Mat3x3( ixx, ixy, izx,
+                            ixy, iyy, iyz,
+                            izx, iyz, izz );
+    inertiaTensor.scale(density);
+}
+
+
+}// namespace Makena
@@ -0,0 +1,69 @@
+#ifndef _MAKENA_MASS_PROPERTIES_HPP_
+#define _MAKENA_MASS_PROPERTIES_HPP_
+
+#include "primitives.hpp"
+#include "manifold.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file mass_properties.hpp
+ *
+ * @brief Finds the exact mass properties of the solid bounded by a closed
+ *        Manifold by the divergence theorem. The volume integrals are
+ *        turned into the integrals over the faces, which are evaluated in
+ *        closed form per triangle of the faces. It takes O(faces) time and
+ *        has no discretization error unlike sampling the volume.
+ *
+ * @reference "Fast and Accurate Computation of Polyhedral Mass Properties"
+ *            B. Mirtich, Journal of Graphics Tools 1(2), 1996
+ *
+ * @reference "Polyhedral Mass Properties (Revisited)" D. Eberly
+ *            https://www.geometrictools.com/Documentation/
+ *                                             PolyhedralMassProperties.pdf
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief finds the mass properties of the solid of uniform density
+ *         bounded by the manifold such as a convex hull.
+ *
+ *  @param solid         (in):  closed manifold whose faces are convex and
+ *                              counter-clockwise seen from outside. It is
+ *                              not modified.
+ *
+ *  @param density       (in):  mass per unit volume
+ *
+ *  @param volume        (out): volume of the solid
+ *
+ *  @param surfaceArea   (out): area of the boundary
+ *
+ *  @param mass          (out): volume times the density
+ *
+ *  @param centerOfMass  (out): center of mass in LCS
+ *
+ *  @param inertiaTensor (out): inertia tensor about the center of mass
+ *                              along the axes of LCS. The off-diagonal
+ *                              elements are the negated products of
+ *                              inertia.
+ */
+void findMassProperties(
+    Manifold&    solid,
+    const double density,
+    double&      volume,
+    double&      surfaceArea,
+    double&      mass,
+    Vec3&        centerOfMass,
+    Mat3x3&      inertiaTensor
+);
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_MASS_PROPERTIES_HPP_*/
@@ -1,3 +1,6 @@
+#include <atomic>
+#include <thread>
+
 #include "primitives.hpp"
 #include "orienting_bounding_box.hpp"
 #include "convex_hull_2d.hpp"
@@ -20,8 +23,40 @@ namespace Makena {
 using namespace std;
 
 
+/** @brief advances the index along the convex polygon to the farthest
+ *         point along the direction. The heights along the polygon are
+ *         unimodal, and the farthest point for the direction rotated
+ *         in the same sense as the polygon is never behind k. The equal
+ *         heights are passed over for the duplicate points.
+ */
+static inline size_t advanceToExtreme(
+    const std::vector<Vec3>& CH,
+    const Vec3&              direction,
+    size_t                   k
+) {
+    const size_t n = CH.size();
+    double h = direction.dot(CH[k]);
+    for (size_t step = 0; step < n; step++) {
+        const size_t next  = (k < n - 1) ? k + 1 : 0;
+        const double hNext = direction.dot(CH[next]);
+        if (hNext < h) {
+            break;
+        }
+        k = next;
+        h = hNext;
+    }
+    return k;
+}
+
+
 /** @brief finds the origented bounding box for the given convex hull
- *         in 2-space spanned by Y and Z axes.
+ *         in 2-space spanned by Y and Z axes by rotating calipers.
+ *
+ *         One side of the optimum box is flush with an edge of the hull.
+ *         The four extreme points along the sides of the box for the edges
+ *         move forward along the hull as the edge advances, and each
+ *         extreme point makes at most one round in total. It takes O(h)
+ *         for the hull of h points.
  *
  *  @param CH         (in):  points along the convex hull ccw.
  *
@@ -42,6 +77,9 @@ using namespace std;
  *  @param extent2    (out): the length of the box along axis 2
  *
  *  @param area        (out): area of the box.
+ *
+ *  @reference "Solving Geometric Problems with the Rotating Calipers",
+ *             G. Toussaint, Proc. IEEE MELECON 1983
  */
 void findOBB2D(
     std::vector<Vec3>& CH,
@@ -55,6 +93,13 @@ void findOBB2D(
     double&            extent2,
     double&            area
 ) {
+    // Indices to the extreme points along +axis1, -axis1, +axis2, -axis2.
+    size_t kMax1 = 0;
+    size_t kMin1 = 0;
+    size_t kMax2 = 0;
+    size_t kMin2 = 0;
+    bool   found = false;
+
     for (size_t i = 0 ; i < CH.size(); i++) {
         size_t j = (i < (CH.size()-1))?i+1:0;
         Vec3 ax0(1.0, 0.0, 0.0);
@@ -65,55 +110,75 @@ void findOBB2D(
         }
         ax1.normalize();
         Vec3 ax2(0.0, -1.0 * ax1.z(), ax1.y());
-        Mat3x3 Minv(ax0, ax1, ax2);
-        Mat3x3 Mrot = Minv.transpose();
-        std::vector<Vec3> rotatedCH;
-        Vec3 pMin;
-        Vec3 pMax;
-        for (size_t k = 0; k < CH.size(); k++) {
-            auto rotP = Mrot * CH[k];
-            if (k ==0) {
-                pMin = rotP;
-                pMax = rotP;
-            }
-            else {
-                if (pMin.y() > rotP.y()) {
-                    pMin.setY(rotP.y());
+
+        if (!found) {
+            // The calipers are placed by brute force on the first edge.
+            for (size_t k = 1; k < CH.size(); k++) {
+                if (ax1.dot(CH[k]) > ax1.dot(CH[kMax1])) {
+                    kMax1 = k;
                 }
-                if (pMin.z() > rotP.z()) {
-                    pMin.setZ(rotP.z());
+                if (ax1.dot(CH[k]) < ax1.dot(CH[kMin1])) {
+                    kMin1 = k;
                 }
-                if (pMax.y() < rotP.y()) {
-                    pMax.setY(rotP.y());
+                if (ax2.dot(CH[k]) > ax2.dot(CH[kMax2])) {
+                    kMax2 = k;
                 }
-                if (pMax.z() < rotP.z()) {
-                    pMax.setZ(rotP.z());
+                if (ax2.dot(CH[k]) < ax2.dot(CH[kMin2])) {
+                    kMin2 = k;
                 }
             }
         }
+        else {
+            kMax1 = advanceToExtreme(CH, ax1,        kMax1);
+            kMin1 = advanceToExtreme(CH, ax1 * -1.0, kMin1);
+            kMax2 = advanceToExtreme(CH, ax2,        kMax2);
+            kMin2 = advanceToExtreme(CH, ax2 * -1.0, kMin2);
+        }
+
+        const double yMin = ax1.dot(CH[kMin1]);
+        const double yMax = ax1.dot(CH[kMax1]);
+        const double zMin = ax2.dot(CH[kMin2]);
+        const double zMax = ax2.dot(CH[kMax2]);
 
-        double curArea = (pMax.y() - pMin.y())*(pMax.z() - pMin.z());
+        double curArea = (yMax - yMin)*(zMax - zMin);
 
-        if (i == 0 || area > curArea) {
+        if (!found || area > curArea) {
+            found = true;
             area = curArea;
             axis1 = ax1;
             axis2 = ax2;
-            Vec3 lowerLeftR (0.0, pMax.y(), pMin.z());
-            Vec3 upperLeftR (0.0, pMax.y(), pMax.z());
-            Vec3 upperRightR(0.0, pMin.y(), pMax.z());
-            Vec3 lowerRightR(0.0, pMin.y(), pMin.z());
+            Mat3x3 Minv(ax0, ax1, ax2);
+            Vec3 lowerLeftR (0.0, yMax, zMin);
+            Vec3 upperLeftR (0.0, yMax, zMax);
+            Vec3 upperRightR(0.0, yMin, zMax);
+            Vec3 lowerRightR(0.0, yMin, zMin);
             lowerLeft =  Minv * lowerLeftR;
             upperLeft =  Minv * upperLeftR;
             upperRight = Minv * upperRightR;
             lowerRight = Minv * lowerRightR;
-            extent1 = pMax.y() - pMin.y();
-            extent2 = pMax.z() - pMin.z();
+            extent1 = yMax - yMin;
+            extent2 = zMax - zMin;
+        }
+    }
+
+    if (!found) {
+        // All the edges are degenerate. The box collapses to a point.
+        axis1   = Vec3(0.0, 1.0, 0.0);
+        axis2   = Vec3(0.0, 0.0, 1.0);
+        extent1 = 0.0;
+        extent2 = 0.0;
+        area    = 0.0;
+        if (!CH.empty()) {
+            lowerLeft  = CH[0];
+            upperLeft  = CH[0];
+            upperRight = CH[0];
+            lowerRight = CH[0];
         }
     }
 }
 
 
-static Mat3x3 findRotationMatrixFromNormal(Vec3& n)
+static Mat3x3 findRotationMatrixFromNormal(const Vec3& n)
 {
     Vec3 axisX(1.0, 0.0, 0.0);
     Vec3 axisY(0.0, 1.0, 0.0);
@@ -178,143 +243,1152 @@ static void findMinMaxAlongX(vector<Vec3>& points, double& xMin, double& xMax)
 }
 
 
-void findOBB3D(
-    Manifold& convexHull,
-    Manifold& obb,
-    Mat3x3&   axes,
-    Vec3&     center,
-    Vec3&     extents,
-    double&   volume
+/** @class OBBCandidate
+ *
+ *  @brief the box found for a normal, i.e., the box with one of its axes
+ *         along the normal.
+ */
+class OBBCandidate {
+  public:
+    Mat3x3 mAxes;
+    Vec3   mExtents;
+    double mVolume;
+
+    Vec3   mFrontLowerLeft;
+    Vec3   mFrontUpperLeft;
+    Vec3   mFrontUpperRight;
+    Vec3   mFrontLowerRight;
+    Vec3   mBackLowerLeft;
+    Vec3   mBackUpperLeft;
+    Vec3   mBackUpperRight;
+    Vec3   mBackLowerRight;
+};
+
+
+/** @brief finds the smallest box that has one of its axes along the normal
+ *         and contains the points.
+ */
+static void findOBBAlongNormal(
+    const vector<Vec3>& points,
+    const Vec3&         n,
+    OBBCandidate&       box
 ) {
-    // Gather points
+    Mat3x3 Mrot = findRotationMatrixFromNormal(n);
 
-    Vec3 frontLowerLeft;
-    Vec3 frontUpperLeft;
-    Vec3 frontUpperRight;
-    Vec3 frontLowerRight;
+    vector<Vec3> rotatedPoints;
+    rotatedPoints.reserve(points.size());
+    for (auto& p : points) {
+        rotatedPoints.push_back(Mrot * p);
+    }
 
-    Vec3 backLowerLeft;
-    Vec3 backUpperLeft;
-    Vec3 backUpperRight;
-    Vec3 backLowerRight;
+    double xMin = 0.0, xMax = 0.0;
+    findMinMaxAlongX(rotatedPoints, xMin, xMax);
 
-    vector<Vec3> points = convexHull.getPointsLCS();
-    if (points.empty()) {
+    Vec3    axisY;
+    Vec3    axisZ;
+    Vec3    backLower;
+    Vec3    backUpper;
+    Vec3    frontUpper;
+    Vec3    frontLower;
+    double  extent1 = 0.0;
+    double  extent2 = 0.0;
+    double  area    = 0.0;
+
+    vector<long> convexHullYZind = findConvexHull2D(rotatedPoints);
+    vector<Vec3> convexHullYZ;
+    for (auto j :convexHullYZind) {
+        convexHullYZ.push_back(rotatedPoints[j]);
+    }
+
+    findOBB2D(
+        convexHullYZ,
+        axisY,
+        axisZ,
+        backLower,
+        backUpper,
+        frontUpper,
+        frontLower,
+        extent1,
+        extent2,
+        area
+    );
+
+    Mat3x3 Minv = Mrot.transpose();
+
+    box.mFrontLowerLeft  = frontLower;
+    box.mFrontLowerRight = frontLower;
+    box.mFrontUpperLeft  = frontUpper;
+    box.mFrontUpperRight = frontUpper;
+
+    box.mFrontLowerLeft.setX(xMin);
+    box.mFrontLowerRight.setX(xMax);
+    box.mFrontUpperLeft.setX(xMin);
+    box.mFrontUpperRight.setX(xMax);
+
+    box.mFrontLowerLeft  = Minv * box.mFrontLowerLeft;
+    box.mFrontLowerRight = Minv * box.mFrontLowerRight;
+    box.mFrontUpperLeft  = Minv * box.mFrontUpperLeft;
+    box.mFrontUpperRight = Minv * box.mFrontUpperRight;
+
+    box.mBackLowerLeft   = backLower;
+    box.mBackLowerRight  = backLower;
+    box.mBackUpperLeft   = backUpper;
+    box.mBackUpperRight  = backUpper;
+
+    box.mBackLowerLeft.setX(xMin);
+    box.mBackLowerRight.setX(xMax);
+    box.mBackUpperLeft.setX(xMin);
+    box.mBackUpperRight.setX(xMax);
+
+    box.mBackLowerLeft  = Minv * box.mBackLowerLeft;
+    box.mBackLowerRight = Minv * box.mBackLowerRight;
+    box.mBackUpperLeft  = Minv * box.mBackUpperLeft;
+    box.mBackUpperRight = Minv * box.mBackUpperRight;
+
+    Mat3x3 curAxes(n, Minv* axisY, Minv* axisZ);
+    box.mAxes = curAxes;
+    box.mExtents.setX(xMax - xMin);
+    box.mExtents.setY(extent1);
+    box.mExtents.setZ(extent2);
+    box.mVolume = area * (xMax - xMin);
+}
+
+
+/** @class OBBSweepScratch
+ *
+ *  @brief the work memory of a thread of the face normal sweep. It is
+ *         reserved for all the points before the sweep.
+ */
+class OBBSweepScratch {
+  public:
+    inline OBBSweepScratch();
+
+    inline void reserve(const long numPoints);
+
+    /** @brief the rotated points in the structure of arrays. */
+    vector<double>        mX;
+    vector<double>        mY;
+    vector<double>        mZ;
+
+    ConvexHull2DWorkspace mHullWorkspace;
+    vector<long>          mHull;
+    vector<Vec3>          mHullYZ;
+
+    /** @brief the best face found by this thread. */
+    double                mBestVolume;
+    long                  mBestFace;
+};
+
+
+inline OBBSweepScratch::OBBSweepScratch():
+    mBestVolume(HUGE_VAL),
+    mBestFace(-1){;}
+
+
+inline void OBBSweepScratch::reserve(const long numPoints)
+{
+    mX.resize(numPoints);
+    mY.resize(numPoints);
+    mZ.resize(numPoints);
+    mHullWorkspace.reserve(numPoints);
+    mHull.reserve(numPoints);
+    mHullYZ.reserve(numPoints);
+}
+
+
+/** @brief finds the volume of the box along the normal in the same way
+ *         as findOBBAlongNormal() with the points in the structure of
+ *         arrays and without the heap allocation.
+ */
+static double findVolumeAlongNormal(
+    const double*    xs,
+    const double*    ys,
+    const double*    zs,
+    const long       numPoints,
+    const Vec3&      n,
+    OBBSweepScratch& scratch
+) {
+    const Mat3x3 Mrot = findRotationMatrixFromNormal(n);
+    const double m11 = Mrot.val(1,1);
+    const double m12 = Mrot.val(1,2);
+    const double m13 = Mrot.val(1,3);
+    const double m21 = Mrot.val(2,1);
+    const double m22 = Mrot.val(2,2);
+    const double m23 = Mrot.val(2,3);
+    const double m31 = Mrot.val(3,1);
+    const double m32 = Mrot.val(3,2);
+    const double m33 = Mrot.val(3,3);
+
+    double* X = scratch.mX.data();
+    double* Y = scratch.mY.data();
+    double* Z = scratch.mZ.data();
+    for (long i = 0; i < numPoints; i++) {
+        X[i] = m11 * xs[i] + m12 * ys[i] + m13 * zs[i];
+        Y[i] = m21 * xs[i] + m22 * ys[i] + m23 * zs[i];
+        Z[i] = m31 * xs[i] + m32 * ys[i] + m33 * zs[i];
+    }
+
+    double xMin = X[0];
+    double xMax = X[0];
+    for (long i = 1; i < numPoints; i++) {
+        xMin = std::min(xMin, X[i]);
+        xMax = std::max(xMax, X[i]);
+    }
+
+    findConvexHull2D(Y, Z, numPoints, scratch.mHullWorkspace, scratch.mHull);
+    scratch.mHullYZ.clear();
+    for (auto j : scratch.mHull) {
+        scratch.mHullYZ.emplace_back(X[j], Y[j], Z[j]);
+    }
+
+    Vec3    axisY;
+    Vec3    axisZ;
+    Vec3    backLower;
+    Vec3    backUpper;
+    Vec3    frontUpper;
+    Vec3    frontLower;
+    double  extent1 = 0.0;
+    double  extent2 = 0.0;
+    double  area    = 0.0;
+
+    findOBB2D(
+        scratch.mHullYZ,
+        axisY,
+        axisZ,
+        backLower,
+        backUpper,
+        frontUpper,
+        frontLower,
+        extent1,
+        extent2,
+        area
+    );
+
+    return area * (xMax - xMin);
+}
+
+
+/** @brief tries the face normals of the hull.
+ *
+ *         The faces are distributed to the threads, and each thread keeps
+ *         its best face. The best faces are reduced to the one with the
+ *         smallest volume and then the smallest index, which is the one
+ *         found by the sequential sweep. Only its box is made.
+ */
+static void findOBBAlongFaceNormals(
+    const CompactMesh& convexHull,
+    const long         numThreads,
+    OBBCandidate&      best
+) {
+    const vector<Vec3>& points      = convexHull.positions();
+    const vector<Vec3>& faceNormals = convexHull.faceNormals();
+    const long          numPoints   = points.size();
+    const long          numFaces    = faceNormals.size();
+
+    vector<double> xs(numPoints);
+    vector<double> ys(numPoints);
+    vector<double> zs(numPoints);
+    for (long i = 0; i < numPoints; i++) {
+        xs[i] = points[i].x();
+        ys[i] = points[i].y();
+        zs[i] = points[i].z();
+    }
+
+    long numWorkers = numThreads;
+    if (numWorkers <= 0) {
+        numWorkers = std::max(1L, (long)std::thread::hardware_concurrency());
+    }
+    numWorkers = std::max(1L, std::min(numWorkers, numFaces));
+
+    vector<OBBSweepScratch> scratches(numWorkers);
+    for (auto& scratch : scratches) {
+        scratch.reserve(numPoints);
+    }
+
+    std::atomic<long>     next(0);
+    vector<exception_ptr> errors(numWorkers);
+
+    auto worker = [&](const long k) {
+        auto& scratch = scratches[k];
+        try {
+            for (long i = next++; i < numFaces; i = next++) {
+                const double volume = findVolumeAlongNormal(
+                    xs.data(), ys.data(), zs.data(), numPoints,
+                    faceNormals[i], scratch);
+                if (scratch.mBestFace == -1 || scratch.mBestVolume > volume) {
+                    scratch.mBestVolume = volume;
+                    scratch.mBestFace   = i;
+                }
+            }
+        }
+        catch (...) {
+            errors[k] = std::current_exception();
+            next = numFaces;
+        }
+    };
+
+    vector<std::thread> threads;
+    for (long k = 1; k < numWorkers; k++) {
+        threads.emplace_back(worker, k);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+    long   bestFace   = -1;
+    double bestVolume = 0.0;
+    for (auto& scratch : scratches) {
+        if (scratch.mBestFace == -1) {
+            continue;
+        }
+        if (bestFace == -1 || bestVolume > scratch.mBestVolume ||
+            (bestVolume == scratch.mBestVolume &&
+             bestFace > scratch.mBestFace)                         ) {
+            bestVolume = scratch.mBestVolume;
+            bestFace   = scratch.mBestFace;
+        }
+    }
+    if (bestFace != -1) {
+        findOBBAlongNormal(points, faceNormals[bestFace], best);
+    }
+    else {
+        // No faces. Make the box along the X axis.
+        findOBBAlongNormal(points, Vec3(1.0, 0.0, 0.0), best);
+    }
+}
+
+
+/** @class OBBEdgeSearch
+ *
+ *  @brief the edge-flush search of OBB_MODE_EDGE_SEARCH.
+ *
+ *         By O'Rourke, a minimum volume box has a face flush with an edge
+ *         of the hull. The normal of such a face is on the arc of the edge
+ *         on the Gauss map, which goes from the normal of one incident face
+ *         to the other. For a normal, the box is the smallest rectangle of
+ *         the projection of the hull extruded by the width along the
+ *         normal. Hence the search minimizes the volume along the arcs of
+ *         all the edges. The face normals are the end points of the arcs.
+ *
+ *         As in Jylanki's algorithm the search works on the Gauss map. The
+ *         outline of the projection is the silhouette, i.e., the edges
+ *         between the faces facing toward and away from the normal, and
+ *         the projection is made of the silhouette vertices only. The
+ *         width is found by hill-climbing from the previous extreme
+ *         vertices. Each arc is sampled, and the lowest sample is refined
+ *         by the golden section search. Unlike the exact algorithm of the
+ *         references, a minimum narrower than ARC_STEP can be missed. The
+ *         final box is made from all the vertices.
+ *
+ *  @reference "Finding minimal enclosing boxes", J. O'Rourke,
+ *             International Journal of Computer & Information Sciences
+ *             14(3), 1985
+ *
+ *  @reference "An Exact Algorithm for Finding Minimum Oriented Bounding
+ *             Boxes", J. Jylanki, 2015
+ */
+class OBBEdgeSearch {
+
+  public:
+
+    /** @brief max angle between the samples on an arc in radian. */
+    static constexpr double ARC_STEP = 0.0175;
+
+    /** @brief number of the golden section steps to refine a sample. */
+    static constexpr long   NUM_REFINEMENTS = 40;
+
+    inline OBBEdgeSearch(const CompactMesh& mesh);
+
+    /** @brief finds the box of the lowest volume found. */
+    void run(OBBCandidate& best);
+
+  private:
+
+    /** @brief finds the volume of the box for the normal from the
+     *         silhouette, and updates the lowest one.
+     */
+    double evaluate(const Vec3& n);
+
+    /** @brief searches the arc of the edge of the half edge. */
+    void searchArc(const uint32_t he);
+
+    uint32_t findExtremeVertex(const Vec3& direction, uint32_t v) const;
+
+    const CompactMesh& mMesh;
+    vector<double>     mFaceVolumes;
+    vector<char>       mFacing;
+    vector<Vec3>       mSilhouette;
+    uint32_t           mVertexMax;
+    uint32_t           mVertexMin;
+    OBBCandidate       mCur;
+    double             mBestVolume;
+    Vec3               mBestNormal;
+
+    /** @brief work memory of searchArc() */
+    vector<double>     mTs;
+    vector<double>     mVolumes;
+};
+
+
+inline OBBEdgeSearch::OBBEdgeSearch(const CompactMesh& mesh):
+    mMesh(mesh),
+    mFaceVolumes(mesh.numFaces()),
+    mFacing(mesh.numFaces()),
+    mVertexMax(0),
+    mVertexMin(0),
+    mBestVolume(HUGE_VAL){;}
+
+
+uint32_t OBBEdgeSearch::findExtremeVertex(
+    const Vec3& direction,
+    uint32_t    v
+) const {
+    double h = direction.dot(mMesh.position(v));
+    while (true) {
+        uint32_t     best  = v;
+        const uint32_t he0 = mMesh.vertexHalfEdge(v);
+        uint32_t     he    = he0;
+        while (he != CompactMesh::INVALID_INDEX) {
+            const uint32_t w  = mMesh.dst(he);
+            const double   hw = direction.dot(mMesh.position(w));
+            if (hw > h) {
+                h    = hw;
+                best = w;
+            }
+            he = mMesh.nextAroundVertexCCW(he);
+            if (he == he0) {
+                break;
+            }
+        }
+        if (best == v) {
+            return v;
+        }
+        v = best;
+    }
+}
+
+
+double OBBEdgeSearch::evaluate(const Vec3& n)
+{
+    for (uint32_t f = 0; f < mMesh.numFaces(); f++) {
+        mFacing[f] = (mMesh.faceNormal(f).dot(n) > 0.0) ? 1 : 0;
+    }
+
+    mSilhouette.clear();
+    for (uint32_t he = 0; he < mMesh.numHalfEdges(); he++) {
+        const uint32_t tw = mMesh.twin(he);
+        if (tw != CompactMesh::INVALID_INDEX &&
+            mFacing[mMesh.face(he)] == 1 && mFacing[mMesh.face(tw)] == 0) {
+            mSilhouette.push_back(mMesh.position(mMesh.src(he)));
+        }
+    }
+
+    mVertexMax = findExtremeVertex(n,        mVertexMax);
+    mVertexMin = findExtremeVertex(n * -1.0, mVertexMin);
+    mSilhouette.push_back(mMesh.position(mVertexMax));
+    mSilhouette.push_back(mMesh.position(mVertexMin));
+
+    findOBBAlongNormal(mSilhouette, n, mCur);
+    if (mBestVolume > mCur.mVolume) {
+        mBestVolume = mCur.mVolume;
+        mBestNormal = n;
+    }
+    return mCur.mVolume;
+}
+
+
+void OBBEdgeSearch::run(OBBCandidate& best)
+{
+    for (uint32_t f = 0; f < mMesh.numFaces(); f++) {
+        mFaceVolumes[f] = evaluate(mMesh.faceNormal(f));
+    }
+
+    for (uint32_t he = 0; he < mMesh.numHalfEdges(); he++) {
+        const uint32_t tw = mMesh.twin(he);
+        if (tw != CompactMesh::INVALID_INDEX && he < tw) {
+            searchArc(he);
+        }
+    }
+
+    // The silhouette may miss the vertices within the tolerance of the
+    // hull, and the volumes above may be smaller than the true ones. The
+    // best face normal is found again from all the vertices, and the box
+    // of the arcs is remade from all the vertices and kept only if it is
+    // smaller.
+    findOBBAlongFaceNormals(mMesh, 1, best);
+    if (mBestVolume < HUGE_VAL) {
+        findOBBAlongNormal(mMesh.positions(), mBestNormal, mCur);
+        if (best.mVolume > mCur.mVolume) {
+            best = mCur;
+        }
+    }
+}
+
+
+void OBBEdgeSearch::searchArc(const uint32_t he)
+{
+    const double invPhi = (sqrt(5.0) - 1.0) / 2.0;
+
+    const uint32_t fa = mMesh.face(he);
+    const uint32_t fb = mMesh.face(mMesh.twin(he));
+    const Vec3&    na = mMesh.faceNormal(fa);
+    const Vec3&    nb = mMesh.faceNormal(fb);
+
+    // n(t) = na cos(t) + u sin(t) for t in [0, theta] goes along the
+    // arc from na to nb.
+    Vec3 u = nb - na * na.dot(nb);
+    if (u.squaredNorm2() < EPSILON_ANGLE * EPSILON_ANGLE) {
         return;
     }
+    u.normalize();
+    const double theta = atan2(nb.dot(u), nb.dot(na));
+    auto normalAt = [&](const double t) {
+        return na * cos(t) + u * sin(t);
+    };
 
-    vector<Vec3> faceNormals = convexHull.getFaceNormalsOriginal();
-    for (size_t i = 0; i < faceNormals.size(); i++) {
+    const long numSteps = max(2L, (long)ceil(theta / ARC_STEP));
+    mTs.resize(numSteps + 1);
+    mVolumes.resize(numSteps + 1);
+    mTs[0]              = 0.0;
+    mVolumes[0]         = mFaceVolumes[fa];
+    mTs[numSteps]       = theta;
+    mVolumes[numSteps]  = mFaceVolumes[fb];
+    long minIndex = (mVolumes[0] <= mVolumes[numSteps]) ? 0 : numSteps;
+    for (long j = 1; j < numSteps; j++) {
+        mTs[j]      = theta * (double)j / (double)numSteps;
+        mVolumes[j] = evaluate(normalAt(mTs[j]));
+        if (mVolumes[j] < mVolumes[minIndex]) {
+            minIndex = j;
+        }
+    }
 
-        auto& n = faceNormals[i];
-        Mat3x3 Mrot = findRotationMatrixFromNormal(n);
+    // The bracket around the lowest sample. At an end point, it is
+    // refined only if the volume decreases into the arc.
+    double lo, hi;
+    if (minIndex == 0) {
+        lo = mTs[0];
+        hi = mTs[1];
+        if (evaluate(normalAt(lo + (hi - lo) * 0.25)) >= mVolumes[0]) {
+            return;
+        }
+    }
+    else if (minIndex == numSteps) {
+        lo = mTs[numSteps - 1];
+        hi = mTs[numSteps];
+        if (evaluate(normalAt(hi - (hi - lo) * 0.25)) >= mVolumes[numSteps]) {
+            return;
+        }
+    }
+    else {
+        lo = mTs[minIndex - 1];
+        hi = mTs[minIndex + 1];
+    }
 
-        vector<Vec3> rotatedPoints;
-        for (auto& p : points) {
-            rotatedPoints.push_back(Mrot * p);
+    double t1 = hi - (hi - lo) * invPhi;
+    double t2 = lo + (hi - lo) * invPhi;
+    double v1 = evaluate(normalAt(t1));
+    double v2 = evaluate(normalAt(t2));
+    for (long k = 0; k < NUM_REFINEMENTS; k++) {
+        if (v1 < v2) {
+            hi = t2;
+            t2 = t1;
+            v2 = v1;
+            t1 = hi - (hi - lo) * invPhi;
+            v1 = evaluate(normalAt(t1));
+        }
+        else {
+            lo = t1;
+            t1 = t2;
+            v1 = v2;
+            t2 = lo + (hi - lo) * invPhi;
+            v2 = evaluate(normalAt(t2));
         }
+    }
+}
 
-        double xMin, xMax;
-        findMinMaxAlongX(rotatedPoints, xMin, xMax);
 
-        Vec3    axisY;
-        Vec3    axisZ;
-        Vec3    backLower;
-        Vec3    backUpper;
-        Vec3    frontUpper;
-        Vec3    frontLower;
-        double  extent1;
-        double  extent2;
-        double  area;
+/** @brief the normals of DiTO-26, i.e., the coordinate axes, the
+ *         diagonals of the cube, and the diagonals of its faces. The first
+ *         7 are the ones of DiTO-14. They are not normalized, as only the
+ *         extremal points along them are used.
+ */
+static const double DITO_NORMALS[13][3] = {
+    { 1.0,  0.0,  0.0},
+    { 0.0,  1.0,  0.0},
+    { 0.0,  0.0,  1.0},
+    { 1.0,  1.0,  1.0},
+    { 1.0,  1.0, -1.0},
+    { 1.0, -1.0,  1.0},
+    { 1.0, -1.0, -1.0},
+    { 1.0,  1.0,  0.0},
+    { 1.0, -1.0,  0.0},
+    { 1.0,  0.0,  1.0},
+    { 1.0,  0.0, -1.0},
+    { 0.0,  1.0,  1.0},
+    { 0.0,  1.0, -1.0}
+};
 
-        vector<long> convexHullYZind = findConvexHull2D(rotatedPoints);
-        vector<Vec3> convexHullYZ;
-        for (auto j :convexHullYZind) {
-            convexHullYZ.push_back(rotatedPoints[j]);
+
+/** @brief finds the lowest and the highest coordinates of the points
+ *         along the axes.
+ */
+static void findExtentsAlongAxes(
+    const Vec3* points,
+    const long  numPoints,
+    const Vec3  axes[3],
+    Vec3&       lo,
+    Vec3&       hi
+) {
+    for (long i = 0; i < numPoints; i++) {
+        const Vec3 p(axes[0].dot(points[i]),
+                     axes[1].dot(points[i]),
+                     axes[2].dot(points[i]));
+        if (i == 0) {
+            lo = p;
+            hi = p;
         }
+        else {
+            lo.setX(std::min(lo.x(), p.x()));
+            lo.setY(std::min(lo.y(), p.y()));
+            lo.setZ(std::min(lo.z(), p.z()));
+            hi.setX(std::max(hi.x(), p.x()));
+            hi.setY(std::max(hi.y(), p.y()));
+            hi.setZ(std::max(hi.z(), p.z()));
+        }
+    }
+}
+
+
+/** @brief makes the box of the right-handed axes from the lowest and the
+ *         highest coordinates along them in the same layout as
+ *         findOBBAlongNormal().
+ */
+static void makeOBBFromExtents(
+    const Vec3    axes[3],
+    const Vec3&   lo,
+    const Vec3&   hi,
+    OBBCandidate& box
+) {
+    auto corner = [&](const double x, const double y, const double z) {
+        return axes[0] * x + axes[1] * y + axes[2] * z;
+    };
+
+    box.mFrontLowerLeft  = corner(lo.x(), lo.y(), lo.z());
+    box.mFrontLowerRight = corner(hi.x(), lo.y(), lo.z());
+    box.mFrontUpperLeft  = corner(lo.x(), lo.y(), hi.z());
+    box.mFrontUpperRight = corner(hi.x(), lo.y(), hi.z());
+    box.mBackLowerLeft   = corner(lo.x(), hi.y(), lo.z());
+    box.mBackLowerRight  = corner(hi.x(), hi.y(), lo.z());
+    box.mBackUpperLeft   = corner(lo.x(), hi.y(), hi.z());
+    box.mBackUpperRight  = corner(hi.x(), hi.y(), hi.z());
+
+    Mat3x3 curAxes(axes[0], axes[1], axes[2]);
+    box.mAxes    = curAxes;
+    box.mExtents = hi - lo;
+    box.mVolume  = box.mExtents.x() * box.mExtents.y() * box.mExtents.z();
+}
+
+
+/** @class OBBFastSearch
+ *
+ *  @brief the DiTO-14 heuristic and the refinement of a box on the raw
+ *         points.
+ *
+ *         The extremal points along the 7 normals of DITO_NORMALS are
+ *         found in one pass. The largest triangle of them, and the two
+ *         tetrahedra on it toward the farthest extremal points on both
+ *         sides, give up to 7 triangles. Each edge of a triangle and the
+ *         normal of the triangle make a candidate set of axes, and the
+ *         candidates are compared by the volume of the box of the 14
+ *         extremal points. The box of the best one is then made from all
+ *         the points. The axis-aligned box is the initial candidate,
+ *         and it is kept if the box of the best one is larger.
+ *
+ *  @reference "Fast Computation of Tight-Fitting Oriented Bounding Boxes",
+ *             T. Larsson and L. Kallberg, Game Engine Gems 2,
+ *             A K Peters 2011
+ */
+class OBBFastSearch {
+
+  public:
+
+    inline OBBFastSearch(const vector<Vec3>& points);
+
+    /** @brief max number of the rounds of refine(). */
+    static constexpr long   MAX_REFINEMENT_ROUNDS = 8;
+
+    /** @brief relative decrease of the volume to continue refine(). */
+    static constexpr double MIN_REFINEMENT_GAIN = 1.0e-6;
+
+    /** @brief finds the box by DiTO-14. */
+    void run(OBBCandidate& best);
+
+    /** @brief rotates the box around one of its axes to the smallest
+     *         rectangle of the projection along it, and repeats it around
+     *         the other axes while the volume decreases.
+     *
+     *         The rotations are found for the extremal points along the 13
+     *         normals of DITO_NORMALS in the frame of the box instead of
+     *         all the points, and the box of all the points along the
+     *         rotated axes replaces the given one only if it is smaller.
+     */
+    void refine(OBBCandidate& best);
 
-        findOBB2D(
-            convexHullYZ,
-            axisY,
-            axisZ,
-            backLower,
-            backUpper,
-            frontUpper,
-            frontLower,
-            extent1,
-            extent2,
-            area
-        );
+  private:
 
-        double curVolume = area * (xMax - xMin);
+    /** @brief tries the 3 sets of axes of the triangle. */
+    void tryTriangle(const Vec3& p0, const Vec3& p1, const Vec3& p2);
 
-        if (i == 0 || volume > curVolume) {
+    /** @brief tries the axes of the unit vectors u and w perpendicular to
+     *         each other.
+     */
+    void tryAxes(const Vec3& u, const Vec3& w);
+
+    const vector<Vec3>& mPoints;
+
+    /** @brief the lowest and the highest extremal points along each normal
+     *         at 2k and 2k+1.
+     */
+    Vec3                mExtremal[14];
+
+    Vec3                mBestAxes[3];
+    double              mBestVolume;
+};
+
+
+inline OBBFastSearch::OBBFastSearch(const vector<Vec3>& points):
+    mPoints(points),
+    mBestVolume(HUGE_VAL){;}
+
+
+void OBBFastSearch::tryAxes(const Vec3& u, const Vec3& w)
+{
+    const Vec3 axes[3] = { u, w.cross(u), w };
+    Vec3 lo, hi;
+    findExtentsAlongAxes(mExtremal, 14, axes, lo, hi);
+    const Vec3   e      = hi - lo;
+    const double volume = e.x() * e.y() * e.z();
+    if (mBestVolume > volume) {
+        mBestVolume  = volume;
+        mBestAxes[0] = axes[0];
+        mBestAxes[1] = axes[1];
+        mBestAxes[2] = axes[2];
+    }
+}
+
+
+void OBBFastSearch::tryTriangle(
+    const Vec3& p0,
+    const Vec3& p1,
+    const Vec3& p2
+) {
+    const Vec3 edges[3] = { p1 - p0, p2 - p1, p0 - p2 };
+    Vec3 n = edges[0].cross(edges[1]);
+    if (n.squaredNorm2() < EPSILON_SQUARED * EPSILON_SQUARED) {
+        return;
+    }
+    n.normalize();
+    for (auto& e : edges) {
+        if (e.squaredNorm2() < EPSILON_SQUARED) {
+            continue;
+        }
+        Vec3 u = e;
+        u.normalize();
+        tryAxes(u, n);
+    }
+}
+
+
+void OBBFastSearch::run(OBBCandidate& best)
+{
+    const long numPoints = mPoints.size();
+
+    long   indices[14];
+    double projections[14];
+    for (long k = 0; k < 7; k++) {
+        const Vec3 n(DITO_NORMALS[k][0], DITO_NORMALS[k][1],
+                     DITO_NORMALS[k][2]);
+        indices[2*k]       = 0;
+        indices[2*k+1]     = 0;
+        projections[2*k]   = n.dot(mPoints[0]);
+        projections[2*k+1] = projections[2*k];
+        for (long i = 1; i < numPoints; i++) {
+            const double d = n.dot(mPoints[i]);
+            if (projections[2*k] > d) {
+                projections[2*k] = d;
+                indices[2*k]     = i;
+            }
+            if (projections[2*k+1] < d) {
+                projections[2*k+1] = d;
+                indices[2*k+1]     = i;
+            }
+        }
+    }
+    for (long j = 0; j < 14; j++) {
+        mExtremal[j] = mPoints[indices[j]];
+    }
+
+    // The axis-aligned box from the slabs of the coordinate axes.
+    mBestAxes[0] = Vec3(1.0, 0.0, 0.0);
+    mBestAxes[1] = Vec3(0.0, 1.0, 0.0);
+    mBestAxes[2] = Vec3(0.0, 0.0, 1.0);
+    const double aabbVolume = (projections[1] - projections[0]) *
+                              (projections[3] - projections[2]) *
+                              (projections[5] - projections[4]);
+    mBestVolume  = aabbVolume;
+
+    // The first edge of the base triangle is the farthest pair of the
+    // extremal points along a normal.
+    long   kFar   = 0;
+    double dist2  = 0.0;
+    for (long k = 0; k < 7; k++) {
+        const double d2 = (mExtremal[2*k+1] - mExtremal[2*k]).squaredNorm2();
+        if (d2 > dist2) {
+            dist2 = d2;
+            kFar  = k;
+        }
+    }
+
+    if (dist2 >= EPSILON_SQUARED) {
+
+        const Vec3& p0 = mExtremal[2*kFar];
+        const Vec3& p1 = mExtremal[2*kFar+1];
+        Vec3 e0 = p1 - p0;
+        e0.normalize();
+
+        // The farthest extremal point from the line of the first edge.
+        long   jFar  = -1;
+        double line2 = 0.0;
+        for (long j = 0; j < 14; j++) {
+            const Vec3   d  = mExtremal[j] - p0;
+            const double t  = d.dot(e0);
+            const double d2 = d.squaredNorm2() - t * t;
+            if (d2 > line2) {
+                line2 = d2;
+                jFar  = j;
+            }
+        }
+
+        if (jFar == -1 || line2 < EPSILON_SQUARED) {
+            // The points are on a line.
+            Mat3x3 Mrot = findRotationMatrixFromNormal(e0);
+            tryAxes(e0, Mrot.row(2));
+        }
+        else {
+            const Vec3& p2 = mExtremal[jFar];
+            tryTriangle(p0, p1, p2);
 
-            Mat3x3 Minv = Mrot.transpose();
+            Vec3 n = (p1 - p0).cross(p2 - p0);
+            n.normalize();
+            const double base = n.dot(p0);
+            long         jLow  = 0;
+            long         jHigh = 0;
+            for (long j = 1; j < 14; j++) {
+                if (n.dot(mExtremal[j]) < n.dot(mExtremal[jLow])) {
+                    jLow = j;
+                }
+                if (n.dot(mExtremal[j]) > n.dot(mExtremal[jHigh])) {
+                    jHigh = j;
+                }
+            }
+            for (auto j : { jLow, jHigh }) {
+                if (fabs(n.dot(mExtremal[j]) - base) < EPSILON_LINEAR) {
+                    continue;
+                }
+                const Vec3& q = mExtremal[j];
+                tryTriangle(p0, p1, q);
+                tryTriangle(p1, p2, q);
+                tryTriangle(p2, p0, q);
+            }
+        }
+    }
 
-            frontLowerLeft  = frontLower;
-            frontLowerRight = frontLower;
-            frontUpperLeft  = frontUpper;
-            frontUpperRight = frontUpper;
+    Vec3 lo, hi;
+    findExtentsAlongAxes(mPoints.data(), numPoints, mBestAxes, lo, hi);
+    makeOBBFromExtents(mBestAxes, lo, hi, best);
 
-            frontLowerLeft.setX(xMin);
-            frontLowerRight.setX(xMax);
-            frontUpperLeft.setX(xMin);
-            frontUpperRight.setX(xMax);
+    // The volume of the candidates is estimated from the extremal points,
+    // while the one of the axis-aligned box is exact.
+    if (best.mVolume > aabbVolume) {
+        const Vec3 axes[3] = { Vec3(1.0, 0.0, 0.0),
+                               Vec3(0.0, 1.0, 0.0),
+                               Vec3(0.0, 0.0, 1.0)  };
+        const Vec3 aabbLo(projections[0], projections[2], projections[4]);
+        const Vec3 aabbHi(projections[1], projections[3], projections[5]);
+        makeOBBFromExtents(axes, aabbLo, aabbHi, best);
+    }
+}
 
-            frontLowerLeft  = Minv * frontLowerLeft;
-            frontLowerRight = Minv * frontLowerRight;
-            frontUpperLeft  = Minv * frontUpperLeft;
-            frontUpperRight = Minv * frontUpperRight;
- 
-            backLowerLeft   = backLower;
-            backLowerRight  = backLower;
-            backUpperLeft   = backUpper;
-            backUpperRight  = backUpper;
+void OBBFastSearch::refine(OBBCandidate& best)
+{
+    // The extremal points along the 13 normals in the frame of the box.
+    const long numPoints = mPoints.size();
+    Vec3       normals[13];
+    long       indices[26];
+    double     projections[26];
+    for (long k = 0; k < 13; k++) {
+        normals[k] = best.mAxes * Vec3(DITO_NORMALS[k][0],
+                                       DITO_NORMALS[k][1],
+                                       DITO_NORMALS[k][2]);
+        indices[2*k]       = 0;
+        indices[2*k+1]     = 0;
+        projections[2*k]   = normals[k].dot(mPoints[0]);
+        projections[2*k+1] = projections[2*k];
+    }
+    for (long i = 1; i < numPoints; i++) {
+        for (long k = 0; k < 13; k++) {
+            const double d = normals[k].dot(mPoints[i]);
+            if (projections[2*k] > d) {
+                projections[2*k] = d;
+                indices[2*k]     = i;
+            }
+            if (projections[2*k+1] < d) {
+                projections[2*k+1] = d;
+                indices[2*k+1]     = i;
+            }
+        }
+    }
 
-            backLowerLeft.setX(xMin);
-            backLowerRight.setX(xMax);
-            backUpperLeft.setX(xMin);
-            backUpperRight.setX(xMax);
+    vector<Vec3>   samples;
+    vector<double> xs;
+    vector<double> ys;
+    vector<double> zs;
+    for (long j = 0; j < 26; j++) {
+        const Vec3& p = mPoints[indices[j]];
+        samples.push_back(p);
+        xs.push_back(p.x());
+        ys.push_back(p.y());
+        zs.push_back(p.z());
+    }
+    const long numSamples = samples.size();
 
-            backLowerLeft  = Minv * backLowerLeft;
-            backLowerRight = Minv * backLowerRight;
-            backUpperLeft  = Minv * backUpperLeft;
-            backUpperRight = Minv * backUpperRight;
+    OBBSweepScratch scratch;
+    scratch.reserve(numSamples);
 
-            Mat3x3 curAxes(n, Minv* axisY, Minv* axisZ);
-            axes = curAxes;
-            extents.setX(xMax - xMin);
-            extents.setY(extent1);
-            extents.setZ(extent2);
-            volume = curVolume;
+    OBBCandidate cur;
+    Vec3         axes[3] = { best.mAxes.col(1), best.mAxes.col(2),
+                             best.mAxes.col(3) };
+    Vec3         lo, hi;
+    findExtentsAlongAxes(samples.data(), numSamples, axes, lo, hi);
+    makeOBBFromExtents(axes, lo, hi, cur);
 
+    // The box is already the smallest one around the axis of the last
+    // round, which is the first axis made by findOBBAlongNormal().
+    long lastAxis = -1;
+    for (long round = 0; round < MAX_REFINEMENT_ROUNDS; round++) {
+        long   bestAxis   = -1;
+        double bestVolume = cur.mVolume * (1.0 - MIN_REFINEMENT_GAIN);
+        for (long k = 0; k < 3; k++) {
+            // The projection along the axis must not be a point.
+            const double e1 = cur.mExtents[(k + 1) % 3 + 1];
+            const double e2 = cur.mExtents[(k + 2) % 3 + 1];
+            if (k == lastAxis ||
+                (e1 < EPSILON_LINEAR && e2 < EPSILON_LINEAR)) {
+                continue;
+            }
+            const double curVolume = findVolumeAlongNormal(
+                xs.data(), ys.data(), zs.data(), numSamples,
+                cur.mAxes.col(k + 1), scratch);
+            if (bestVolume > curVolume) {
+                bestVolume = curVolume;
+                bestAxis   = k;
+            }
+        }
+        if (bestAxis == -1) {
+            break;
         }
+        const Vec3 n = cur.mAxes.col(bestAxis + 1);
+        findOBBAlongNormal(samples, n, cur);
+        lastAxis = 0;
+    }
+    if (lastAxis == -1) {
+        return;
     }
 
+    // The box of all the points along the refined axes.
+    for (long k = 0; k < 3; k++) {
+        axes[k] = cur.mAxes.col(k + 1);
+    }
+    findExtentsAlongAxes(mPoints.data(), numPoints, axes, lo, hi);
+    makeOBBFromExtents(axes, lo, hi, cur);
+    if (best.mVolume > cur.mVolume) {
+        best = cur;
+    }
+}
+
+
+/** @brief makes the box of the points along their principal axes.
+ *
+ *  @return false if the axes are not found for the degenerate points.
+ */
+static bool findOBBAlongPrincipalAxes(
+    const vector<Vec3>& points,
+    OBBCandidate&       box
+) {
+    if (points.size() < 4) {
+        return false;
+    }
+    Vec3   spread;
+    Vec3   mean;
+    Mat3x3 pca = findPrincipalComponents(points, spread, mean);
+
+    // The third axis is made from the first two for the right-handedness.
+    Vec3 axes[3] = { pca.col(1), pca.col(2), pca.col(1).cross(pca.col(2)) };
+    if (!(fabs(axes[0].squaredNorm2() - 1.0) < EPSILON_LINEAR &&
+          fabs(axes[1].squaredNorm2() - 1.0) < EPSILON_LINEAR &&
+          fabs(axes[0].dot(axes[1]))         < EPSILON_ANGLE     )) {
+        return false;
+    }
+    axes[2].normalize();
+
+    Vec3 lo, hi;
+    findExtentsAlongAxes(points.data(), points.size(), axes, lo, hi);
+    makeOBBFromExtents(axes, lo, hi, box);
+    return true;
+}
+
+
+/** @brief sets the outputs of findOBB3D() from the box. */
+static void setOBB3DOutputs(
+    const OBBCandidate& best,
+    Manifold&           obb,
+    Mat3x3&             axes,
+    Vec3&               center,
+    Vec3&               extents,
+    double&             volume
+) {
+    axes    = best.mAxes;
+    extents = best.mExtents;
+    volume  = best.mVolume;
+
     obb.constructCuboid(
-        frontLowerLeft,
-        frontUpperLeft,
-        frontUpperRight,
-        frontLowerRight,
-        backLowerLeft,
-        backUpperLeft,
-        backUpperRight,
-        backLowerRight
+        best.mFrontLowerLeft,
+        best.mFrontUpperLeft,
+        best.mFrontUpperRight,
+        best.mFrontLowerRight,
+        best.mBackLowerLeft,
+        best.mBackUpperLeft,
+        best.mBackUpperRight,
+        best.mBackLowerRight
     );
 
     center = 
-        frontLowerLeft  +
-        frontUpperLeft  +
-        frontUpperRight +
-        frontLowerRight +
-        backLowerLeft   +
-        backUpperLeft   +
-        backUpperRight  +
-        backLowerRight;
+        best.mFrontLowerLeft  +
+        best.mFrontUpperLeft  +
+        best.mFrontUpperRight +
+        best.mFrontLowerRight +
+        best.mBackLowerLeft   +
+        best.mBackUpperLeft   +
+        best.mBackUpperRight  +
+        best.mBackLowerRight;
 
     center.scale(1.0/8.0);
+}
+
+void findOBB3D(
+    Manifold& convexHull,
+    Manifold& obb,
+    Mat3x3&   axes,
+    Vec3&     center,
+    Vec3&     extents,
+    double&   volume
+) {
+    findOBB3D(
+        convexHull, obb, axes, center, extents, volume, OBB_MODE_FACE_NORMALS);
+}
+
+
+void findOBB3D(
+    Manifold&    convexHull,
+    Manifold&    obb,
+    Mat3x3&      axes,
+    Vec3&        center,
+    Vec3&        extents,
+    double&      volume,
+    enum OBBMode mode,
+    const long   numThreads
+) {
+    CompactMesh mesh;
+    mesh.build(convexHull);
+    findOBB3D(mesh, obb, axes, center, extents, volume, mode, numThreads);
+}
+
+
+void findOBB3D(
+    const CompactMesh& convexHull,
+    Manifold&          obb,
+    Mat3x3&            axes,
+    Vec3&              center,
+    Vec3&              extents,
+    double&            volume
+) {
+    findOBB3D(
+        convexHull, obb, axes, center, extents, volume, OBB_MODE_FACE_NORMALS);
+}
+
+
+void findOBB3D(
+    const CompactMesh& convexHull,
+    Manifold&          obb,
+    Mat3x3&            axes,
+    Vec3&              center,
+    Vec3&              extents,
+    double&            volume,
+    enum OBBMode       mode,
+    const long         numThreads
+) {
+    if (convexHull.positions().empty()) {
+        return;
+    }
+
+    OBBCandidate best;
+    if (mode == OBB_MODE_EDGE_SEARCH) {
+        OBBEdgeSearch search(convexHull);
+        search.run(best);
+    }
+    else {
+        findOBBAlongFaceNormals(convexHull, numThreads, best);
+    }
+
+    setOBB3DOutputs(best, obb, axes, center, extents, volume);
+}
+
+
+void findOBB3DFast(
+    const vector<Vec3>& points,
+    Manifold&           obb,
+    Mat3x3&             axes,
+    Vec3&               center,
+    Vec3&               extents,
+    double&             volume
+) {
+    if (points.empty()) {
+        return;
+    }
+
+    OBBCandidate  best;
+    OBBFastSearch search(points);
+    search.run(best);
+    search.refine(best);
+
+    // The principal axes often lead to a better box where DiTO-14 does
+    // not.
+    OBBCandidate pcaBox;
+    if (findOBBAlongPrincipalAxes(points, pcaBox)) {
+        search.refine(pcaBox);
+        if (best.mVolume > pcaBox.mVolume) {
+            best = pcaBox;
+        }
+    }
 
+    setOBB3DOutputs(best, obb, axes, center, extents, volume);
 }
 
 
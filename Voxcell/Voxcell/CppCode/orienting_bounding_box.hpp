@@ -13,6 +13,7 @@
 
 #include "primitives.hpp"
 #include "manifold.hpp"
+#include "compact_mesh.hpp"
 
 
 #ifdef UNIT_TESTS
@@ -34,7 +35,10 @@ using namespace std;
 
 
 /** @brief finds the optimum oriented bounding box for the given convex hull
- *         in 2-space spanned by Y and Z axes.
+ *         in 2-space spanned by Y and Z axes by rotating calipers in O(h)
+ *         for the hull of h points. If no edge of the hull is longer than
+ *         EPSILON, the extents and the area are 0, and the corners are
+ *         at the first point of the hull.
  *
  *  @param CH         (in):  points along the convex hull ccw.
  *
@@ -70,7 +74,29 @@ void findOBB2D(
 );
 
 
+/** @brief the search modes of findOBB3D(). */
+enum OBBMode {
+
+    /** @brief tries the face normals of the hull. The box has a face
+     *         flush with a face of the hull. It is a heuristic, and the box
+     *         may be larger than the minimum.
+     */
+    OBB_MODE_FACE_NORMALS,
+
+    /** @brief searches the boxes that have a face flush with an edge of
+     *         the hull, among which a minimum volume box is. The arc of
+     *         each edge on the Gauss map is sampled at about 1 degree, and
+     *         the lowest sample is refined by the golden section search.
+     *         It is not exact, as a narrow minimum between the samples can
+     *         be missed, but the box is never larger than the one of
+     *         OBB_MODE_FACE_NORMALS.
+     */
+    OBB_MODE_EDGE_SEARCH
+};
+
+
 /** @brief finds the oriented bounding box for the given convex hull
+ *         with OBB_MODE_FACE_NORMALS.
  *
  *  @param convexHull (in):  convex hull
  *
@@ -94,6 +120,85 @@ void findOBB3D(
 );
 
 
+/** @brief findOBB3D() for the convex hull given as a CompactMesh.
+ */
+void findOBB3D(
+    const CompactMesh& convexHull,
+    Manifold&          obb,
+    Mat3x3&            axes,
+    Vec3&              center,
+    Vec3&              extent,
+    double&            volume
+);
+
+
+/** @brief findOBB3D() with the search mode.
+ *
+ *  @param mode       (in): the search mode
+ *
+ *  @param numThreads (in): the number of the threads for the face normals
+ *                          of OBB_MODE_FACE_NORMALS. 0 means
+ *                          std::thread::hardware_concurrency(). The result
+ *                          does not depend on it.
+ */
+void findOBB3D(
+    Manifold&    convexHull,
+    Manifold&    obb,
+    Mat3x3&      axes,
+    Vec3&        center,
+    Vec3&        extent,
+    double&      volume,
+    enum OBBMode mode,
+    const long   numThreads = 1
+);
+
+
+/** @brief findOBB3D() for the convex hull given as a CompactMesh with the
+ *         search mode.
+ */
+void findOBB3D(
+    const CompactMesh& convexHull,
+    Manifold&          obb,
+    Mat3x3&            axes,
+    Vec3&              center,
+    Vec3&              extent,
+    double&            volume,
+    enum OBBMode       mode,
+    const long         numThreads = 1
+);
+
+
+/** @brief finds an oriented bounding box for the given points quickly
+ *         without making their convex hull.
+ *
+ *         Two boxes are made, one by DiTO-14 from the extremal points
+ *         along 7 fixed normals, and the other along the principal axes.
+ *         Each box is then rotated around its axes to the smallest
+ *         rectangle of the projection of the extremal points along 13
+ *         normals in its frame, and the smaller one is returned. It runs
+ *         in O(n) for n points. The box is a few percent larger than the
+ *         one of findOBB3D() with OBB_MODE_EDGE_SEARCH in general, and never
+ *         larger than the axis-aligned box.
+ *
+ *  @param points     (in):  the points. They need not be convex. They are
+ *                           not modified.
+ *
+ *  @param obb, axes, center, extent, volume (out): same as findOBB3D().
+ *
+ *  @reference "Fast Computation of Tight-Fitting Oriented Bounding Boxes",
+ *             T. Larsson and L. Kallberg, Game Engine Gems 2,
+ *             A K Peters 2011
+ */
+void findOBB3DFast(
+    const vector<Vec3>& points,
+    Manifold&           obb,
+    Mat3x3&             axes,
+    Vec3&               center,
+    Vec3&               extent,
+    double&             volume
+);
+
+
 #ifdef UNIT_TESTS
 
 void makeOpenGLVerticesColorsForAxes(
@@ -0,0 +1,257 @@
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "point_classifier.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file point_classifier.cpp
+ *
+ * @brief Classifies blocks of points against the plane of a convex face.
+ *
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief scalar version of classifyPointBlock() for the points [begin,end).
+ *         The operations are in the same order as Face::isFacing().
+ */
+static inline void classifyPointsScalar(
+    const double*       xs,
+    const double*       ys,
+    const double*       zs,
+    const long          begin,
+    const long          end,
+    const vector<Vec3>& vertices,
+    const Vec3&         normal,
+    const double        eps,
+    uint64_t&           facing,
+    uint64_t&           coplanar
+) {
+    for (long i = begin; i < end; i++) {
+
+        double distMax = 0.0;
+        double mx = 0.0, my = 0.0, mz = 0.0;
+        for (auto& c : vertices) {
+            const double vx = xs[i] - c.x();
+            const double vy = ys[i] - c.y();
+            const double vz = zs[i] - c.z();
+            const double sqDist = vx*vx + vy*vy + vz*vz;
+            if (distMax < sqDist) {
+                distMax = sqDist;
+                mx = c.x();
+                my = c.y();
+                mz = c.z();
+            }
+        }
+
+        const double vertDist = (xs[i] - mx) * normal.x() +
+                                (ys[i] - my) * normal.y() +
+                                (zs[i] - mz) * normal.z();
+
+        if (fabs(vertDist) < eps) {
+            coplanar |= (1ULL << i);
+        }
+        else if (vertDist > 0.0) {
+            facing   |= (1ULL << i);
+        }
+    }
+}
+
+
+#if !defined(__AVX2__) && !defined(__SSE2__) && \
+    defined(__ARM_NEON) && defined(__aarch64__)
+
+/** @brief NEON counterpart of _mm_movemask_pd(). */
+static inline uint64_t movemaskNeon(const uint64x2_t mask)
+{
+    return (vgetq_lane_u64(mask, 0) >> 63) |
+           ((vgetq_lane_u64(mask, 1) >> 63) << 1);
+}
+
+#endif
+
+
+void classifyPointBlock(
+    const double*       xs,
+    const double*       ys,
+    const double*       zs,
+    const long          numPoints,
+    const vector<Vec3>& vertices,
+    const Vec3&         normal,
+    const double        eps,
+    uint64_t&           facing,
+    uint64_t&           coplanar,
+    uint64_t&           behind
+) {
+    facing   = 0;
+    coplanar = 0;
+    long i   = 0;
+
+#if defined(__AVX2__)
+
+    const __m256d nx   = _mm256_set1_pd(normal.x());
+    const __m256d ny   = _mm256_set1_pd(normal.y());
+    const __m256d nz   = _mm256_set1_pd(normal.z());
+    const __m256d veps = _mm256_set1_pd(eps);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    for (; i + 4 <= numPoints; i += 4) {
+
+        const __m256d px = _mm256_loadu_pd(xs + i);
+        const __m256d py = _mm256_loadu_pd(ys + i);
+        const __m256d pz = _mm256_loadu_pd(zs + i);
+
+        __m256d distMax = zero;
+        __m256d mx = zero, my = zero, mz = zero;
+        for (auto& c : vertices) {
+            const __m256d cx = _mm256_set1_pd(c.x());
+            const __m256d cy = _mm256_set1_pd(c.y());
+            const __m256d cz = _mm256_set1_pd(c.z());
+            const __m256d vx = _mm256_sub_pd(px, cx);
+            const __m256d vy = _mm256_sub_pd(py, cy);
+            const __m256d vz = _mm256_sub_pd(pz, cz);
+            const __m256d sqDist = _mm256_add_pd(
+                    _mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy)),
+                    _mm256_mul_pd(vz, vz));
+            const __m256d further = _mm256_cmp_pd(distMax, sqDist, _CMP_LT_OQ);
+            distMax = _mm256_blendv_pd(distMax, sqDist, further);
+            mx      = _mm256_blendv_pd(mx, cx, further);
+            my      = _mm256_blendv_pd(my, cy, further);
+            mz      = _mm256_blendv_pd(mz, cz, further);
+        }
+
+        const __m256d vertDist = _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(px, mx), nx),
+                          _mm256_mul_pd(_mm256_sub_pd(py, my), ny)),
+            _mm256_mul_pd(_mm256_sub_pd(pz, mz), nz));
+
+        const __m256d absDist = _mm256_andnot_pd(sign, vertDist);
+        const __m256d isCop   = _mm256_cmp_pd(absDist, veps, _CMP_LT_OQ);
+        const __m256d isPos   = _mm256_cmp_pd(vertDist, zero, _CMP_GT_OQ);
+        const __m256d isFac   = _mm256_andnot_pd(isCop, isPos);
+
+        coplanar |= ((uint64_t)_mm256_movemask_pd(isCop)) << i;
+        facing   |= ((uint64_t)_mm256_movemask_pd(isFac)) << i;
+    }
+
+#elif defined(__SSE2__)
+
+    const __m128d nx   = _mm_set1_pd(normal.x());
+    const __m128d ny   = _mm_set1_pd(normal.y());
+    const __m128d nz   = _mm_set1_pd(normal.z());
+    const __m128d veps = _mm_set1_pd(eps);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d sign = _mm_set1_pd(-0.0);
+
+    for (; i + 2 <= numPoints; i += 2) {
+
+        const __m128d px = _mm_loadu_pd(xs + i);
+        const __m128d py = _mm_loadu_pd(ys + i);
+        const __m128d pz = _mm_loadu_pd(zs + i);
+
+        __m128d distMax = zero;
+        __m128d mx = zero, my = zero, mz = zero;
+        for (auto& c : vertices) {
+            const __m128d cx = _mm_set1_pd(c.x());
+            const __m128d cy = _mm_set1_pd(c.y());
+            const __m128d cz = _mm_set1_pd(c.z());
+            const __m128d vx = _mm_sub_pd(px, cx);
+            const __m128d vy = _mm_sub_pd(py, cy);
+            const __m128d vz = _mm_sub_pd(pz, cz);
+            const __m128d sqDist = _mm_add_pd(
+                    _mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)),
+                    _mm_mul_pd(vz, vz));
+            // SSE2 has no blendv.
+            const __m128d further = _mm_cmplt_pd(distMax, sqDist);
+            distMax = _mm_or_pd(_mm_and_pd(further, sqDist),
+                                _mm_andnot_pd(further, distMax));
+            mx      = _mm_or_pd(_mm_and_pd(further, cx),
+                                _mm_andnot_pd(further, mx));
+            my      = _mm_or_pd(_mm_and_pd(further, cy),
+                                _mm_andnot_pd(further, my));
+            mz      = _mm_or_pd(_mm_and_pd(further, cz),
+                                _mm_andnot_pd(further, mz));
+        }
+
+        const __m128d vertDist = _mm_add_pd(
+            _mm_add_pd(_mm_mul_pd(_mm_sub_pd(px, mx), nx),
+                       _mm_mul_pd(_mm_sub_pd(py, my), ny)),
+            _mm_mul_pd(_mm_sub_pd(pz, mz), nz));
+
+        const __m128d absDist = _mm_andnot_pd(sign, vertDist);
+        const __m128d isCop   = _mm_cmplt_pd(absDist, veps);
+        const __m128d isPos   = _mm_cmpgt_pd(vertDist, zero);
+        const __m128d isFac   = _mm_andnot_pd(isCop, isPos);
+
+        coplanar |= ((uint64_t)_mm_movemask_pd(isCop)) << i;
+        facing   |= ((uint64_t)_mm_movemask_pd(isFac)) << i;
+    }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    const float64x2_t nx   = vdupq_n_f64(normal.x());
+    const float64x2_t ny   = vdupq_n_f64(normal.y());
+    const float64x2_t nz   = vdupq_n_f64(normal.z());
+    const float64x2_t veps = vdupq_n_f64(eps);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+
+    for (; i + 2 <= numPoints; i += 2) {
+
+        const float64x2_t px = vld1q_f64(xs + i);
+        const float64x2_t py = vld1q_f64(ys + i);
+        const float64x2_t pz = vld1q_f64(zs + i);
+
+        float64x2_t distMax = zero;
+        float64x2_t mx = zero, my = zero, mz = zero;
+        for (auto& c : vertices) {
+            const float64x2_t cx = vdupq_n_f64(c.x());
+            const float64x2_t cy = vdupq_n_f64(c.y());
+            const float64x2_t cz = vdupq_n_f64(c.z());
+            const float64x2_t vx = vsubq_f64(px, cx);
+            const float64x2_t vy = vsubq_f64(py, cy);
+            const float64x2_t vz = vsubq_f64(pz, cz);
+            const float64x2_t sqDist = vaddq_f64(
+                    vaddq_f64(vmulq_f64(vx, vx), vmulq_f64(vy, vy)),
+                    vmulq_f64(vz, vz));
+            const uint64x2_t further = vcltq_f64(distMax, sqDist);
+            distMax = vbslq_f64(further, sqDist, distMax);
+            mx      = vbslq_f64(further, cx, mx);
+            my      = vbslq_f64(further, cy, my);
+            mz      = vbslq_f64(further, cz, mz);
+        }
+
+        const float64x2_t vertDist = vaddq_f64(
+            vaddq_f64(vmulq_f64(vsubq_f64(px, mx), nx),
+                      vmulq_f64(vsubq_f64(py, my), ny)),
+            vmulq_f64(vsubq_f64(pz, mz), nz));
+
+        const uint64x2_t isCop = vcltq_f64(vabsq_f64(vertDist), veps);
+        const uint64x2_t isPos = vcgtq_f64(vertDist, zero);
+        const uint64x2_t isFac = vbicq_u64(isPos, isCop);
+
+        coplanar |= movemaskNeon(isCop) << i;
+        facing   |= movemaskNeon(isFac) << i;
+    }
+
+#endif
+
+    classifyPointsScalar(
+        xs, ys, zs, i, numPoints, vertices, normal, eps, facing, coplanar);
+
+    const uint64_t all = (numPoints >= 64) ? ~0ULL : ((1ULL << numPoints) - 1);
+    behind = all & ~(facing | coplanar);
+}
+
+
+}// namespace Makena
@@ -0,0 +1,85 @@
+#ifndef _MAKENA_POINT_CLASSIFIER_HPP_
+#define _MAKENA_POINT_CLASSIFIER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "primitives.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file point_classifier.hpp
+ *
+ * @brief Classifies blocks of points against the plane of a convex face.
+ *        It uses AVX2 or SSE2 on x86, NEON on arm64, and otherwise scalar
+ *        code.
+ *
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @brief max number of points classified in one call, i.e., the number
+ *         of the bits in the masks.
+ */
+static constexpr long POINT_BLOCK_SIZE = 64;
+
+
+/** @brief classifies the given points against the plane of a face
+ *         with the same semantics as Face::isFacing().
+ *
+ *         For each point p, the vertex c of the face furthest from p is
+ *         found, and the signed distance d = (p - c).n is calculated.
+ *         The point is
+ *
+ *         - coplanar if |d| < eps, which is MAYBE_COPLANAR in isFacing(),
+ *         - facing   if d > 0 and not coplanar, which is isFacing() with
+ *                    NONE,
+ *         - behind   otherwise.
+ *
+ *         Bit i of the masks corresponds to point i.
+ *
+ *  @param xs        (in):  the x coordinates of the points.
+ *
+ *  @param ys        (in):  the y coordinates of the points.
+ *
+ *  @param zs        (in):  the z coordinates of the points.
+ *
+ *  @param numPoints (in):  the number of points. At most POINT_BLOCK_SIZE.
+ *
+ *  @param vertices  (in):  the vertices of the face in the order of
+ *                          its incident half edges.
+ *
+ *  @param normal    (in):  the normal of the face.
+ *
+ *  @param eps       (in):  margin for the coplanarity.
+ *
+ *  @param facing    (out): the points in front of the face.
+ *
+ *  @param coplanar  (out): the points on the plane of the face.
+ *
+ *  @param behind    (out): the points behind the face.
+ */
+void classifyPointBlock(
+    const double*       xs,
+    const double*       ys,
+    const double*       zs,
+    const long          numPoints,
+    const vector<Vec3>& vertices,
+    const Vec3&         normal,
+    const double        eps,
+    uint64_t&           facing,
+    uint64_t&           coplanar,
+    uint64_t&           behind
+);
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_POINT_CLASSIFIER_HPP_*/
@@ -376,8 +376,11 @@ Vec3 Mat3x3::findEigenVectorInSubSpace(Vec3& Ev1, double lambda2)
 }
 
 
-Mat3x3 findPrincipalComponents(vector<Vec3>& points, Vec3& spread, Vec3& mean)
-{
+Mat3x3 findPrincipalComponents(
+    const vector<Vec3>& points,
+    Vec3&               spread,
+    Vec3&               mean
+) {
     const Vec3 zero(0.0, 0.0, 0.0);
     if (points.size()==0) {
         mean   = zero;
@@ -326,7 +326,11 @@ protected:
  *  @return a matrix whose 3 columns specify the principal component axes.
  *          They are normalized vectors.
  */
-Mat3x3 findPrincipalComponents(vector<Vec3>& points, Vec3& spread, Vec3& mean);
+Mat3x3 findPrincipalComponents(
+    const vector<Vec3>& points,
+    Vec3&               spread,
+    Vec3&               mean
+);
 
 
 
@@ -0,0 +1,238 @@
+#include <cmath>
+
+#include "separating_axis.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file separating_axis.cpp
+ *
+ * @brief Overlap test of two convex Manifolds by the separating axis
+ *        theorem.
+ */
+namespace Makena {
+
+using namespace std;
+
+
+bool SATShape::build(Manifold& m)
+{
+    clear();
+
+    auto vPair = m.vertices();
+    for (auto vit = vPair.first; vit != vPair.second; vit++) {
+        mVertices.push_back((*vit)->pLCS());
+    }
+    if (mVertices.size() < 4) {
+        clear();
+        return false;
+    }
+
+    Vec3 sum(0.0, 0.0, 0.0);
+    for (auto& v : mVertices) {
+        sum = sum + v;
+    }
+    mCenter = sum * (1.0 / (double)mVertices.size());
+
+    mFaceNormals = m.getFaceNormalsOriginal();
+    auto fPair   = m.faces();
+    long index   = 0;
+    for (auto fit = fPair.first; fit != fPair.second; fit++, index++) {
+        auto& halfEdges = (*fit)->halfEdges();
+        if (halfEdges.empty()) {
+            clear();
+            return false;
+        }
+        const Vec3& p = (*(*(*halfEdges.begin()))->src())->pLCS();
+        mFaceOffsets.push_back(mFaceNormals[index].dot(p));
+    }
+
+    auto ePair = m.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto he1 = (*eit)->he1();
+        auto he2 = (*eit)->he2();
+        if (he1 == he2) {
+            clear();
+            return false;
+        }
+        const Vec3& src = (*((*he1)->src()))->pLCS();
+        const Vec3& dst = (*((*he1)->dst()))->pLCS();
+        mEdgePoints.push_back(src);
+        mEdgeDirections.push_back(dst - src);
+        mEdgeNormals1.push_back((*((*he1)->face()))->nLCS());
+        mEdgeNormals2.push_back((*((*he2)->face()))->nLCS());
+    }
+    return true;
+}
+
+
+void SATTester::setBodies(
+    const SATShape&   A,
+    const Quaternion& qA,
+    const Vec3&       pA,
+    const SATShape&   B,
+    const Quaternion& qB,
+    const Vec3&       pB
+) {
+    mA = &A;
+    mB = &B;
+
+    const Mat3x3 rotA    = qA.rotationMatrix();
+    const Mat3x3 rotB    = qB.rotationMatrix();
+    const Mat3x3 invRotA = rotA.transpose();
+    const Mat3x3 invRotB = rotB.transpose();
+
+    mRotBA = invRotA * rotB;
+    mPosBA = invRotA * (pB - pA);
+    mRotAB = invRotB * rotA;
+    mPosAB = invRotB * (pA - pB);
+}
+
+
+double SATTester::separationEdges(const long indexA, const long indexB) const
+{
+    const Vec3& eA = mA->mEdgeDirections[indexA];
+    const Vec3& eB = mEdgeDirectionsB[indexB];
+    Vec3 axis = eA.cross(eB);
+
+    // Parallel edges. The axis is covered by the face normals.
+    const double len2 = axis.squaredNorm2();
+    if (len2 <= EPSILON_SQUARED * eA.squaredNorm2() * eB.squaredNorm2()) {
+        return -HUGE_VAL;
+    }
+    axis.scale(1.0 / sqrt(len2));
+
+    const Vec3& pointA = mA->mEdgePoints[indexA];
+    if (axis.dot(pointA - mA->mCenter) < 0.0) {
+        axis.scale(-1.0);
+    }
+    return axis.dot(mEdgePointsB[indexB] - pointA);
+}
+
+
+double SATTester::separationCached(const SATCache& cache) const
+{
+    switch (cache.mType) {
+
+      case SATCache::AXIS_FACE_A:
+        if (cache.mIndex1 < mA->numFaces()) {
+            return separationFaceA(cache.mIndex1);
+        }
+        break;
+
+      case SATCache::AXIS_FACE_B:
+        if (cache.mIndex1 < mB->numFaces()) {
+            return separationFaceB(cache.mIndex1);
+        }
+        break;
+
+      case SATCache::AXIS_EDGES:
+        if (cache.mIndex1 < mA->numEdges() && cache.mIndex2 < mB->numEdges()
+            && isMinkowskiFace(cache.mIndex1, cache.mIndex2)) {
+            return separationEdges(cache.mIndex1, cache.mIndex2);
+        }
+        break;
+
+      default:
+        break;
+    }
+    return -HUGE_VAL;
+}
+
+
+bool SATTester::overlap(
+    const SATShape&   A,
+    const Quaternion& qA,
+    const Vec3&       pA,
+    const SATShape&   B,
+    const Quaternion& qB,
+    const Vec3&       pB,
+    SATCache&         cache
+) {
+    mNumTests++;
+
+    if (A.empty() || B.empty()) {
+        cache.clear();
+        return false;
+    }
+    setBodies(A, qA, pA, B, qB, pB);
+
+    // The edges of B in LCS of A are made lazily, as the cached face
+    // axis rejects most of the separated pairs without them.
+    bool edgesReady = false;
+    auto prepareEdges = [&]() {
+        if (edgesReady) {
+            return;
+        }
+        const long numEdgesB = B.numEdges();
+        mEdgePointsB.resize(numEdgesB);
+        mEdgeDirectionsB.resize(numEdgesB);
+        mEdgeNormals1B.resize(numEdgesB);
+        mEdgeNormals2B.resize(numEdgesB);
+        for (long i = 0; i < numEdgesB; i++) {
+            mEdgePointsB[i]     = mRotBA * B.mEdgePoints[i] + mPosBA;
+            mEdgeDirectionsB[i] = mRotBA * B.mEdgeDirections[i];
+            mEdgeNormals1B[i]   = mRotBA * B.mEdgeNormals1[i];
+            mEdgeNormals2B[i]   = mRotBA * B.mEdgeNormals2[i];
+        }
+        edgesReady = true;
+    };
+
+    if (cache.mType != SATCache::AXIS_NONE) {
+        if (cache.mType == SATCache::AXIS_EDGES) {
+            prepareEdges();
+            mNumEdgeAxesTested++;
+        }
+        else {
+            mNumFaceAxesTested++;
+        }
+        if (separationCached(cache) > 0.0) {
+            mNumCacheHits++;
+            return false;
+        }
+    }
+
+    for (long i = 0; i < A.numFaces(); i++) {
+        mNumFaceAxesTested++;
+        if (separationFaceA(i) > 0.0) {
+            cache.mType   = SATCache::AXIS_FACE_A;
+            cache.mIndex1 = i;
+            return false;
+        }
+    }
+
+    for (long i = 0; i < B.numFaces(); i++) {
+        mNumFaceAxesTested++;
+        if (separationFaceB(i) > 0.0) {
+            cache.mType   = SATCache::AXIS_FACE_B;
+            cache.mIndex1 = i;
+            return false;
+        }
+    }
+
+    prepareEdges();
+    for (long i = 0; i < A.numEdges(); i++) {
+        for (long j = 0; j < B.numEdges(); j++) {
+            if (!isMinkowskiFace(i, j)) {
+                mNumEdgePairsPruned++;
+                continue;
+            }
+            mNumEdgeAxesTested++;
+            if (separationEdges(i, j) > 0.0) {
+                cache.mType   = SATCache::AXIS_EDGES;
+                cache.mIndex1 = i;
+                cache.mIndex2 = j;
+                return false;
+            }
+        }
+    }
+
+    cache.clear();
+    return true;
+}
+
+
+}// namespace Makena
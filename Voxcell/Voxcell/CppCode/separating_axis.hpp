@@ -0,0 +1,422 @@
+#ifndef _MAKENA_SEPARATING_AXIS_HPP_
+#define _MAKENA_SEPARATING_AXIS_HPP_
+
+#include <vector>
+
+#include "primitives.hpp"
+#include "quaternion.hpp"
+#include "manifold.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file separating_axis.hpp
+ *
+ * @brief Overlap test of two convex Manifolds placed in the world by rigid
+ *        transforms by the separating axis theorem.
+ *
+ *        The candidate axes are the face normals of both bodies, and the
+ *        cross products of the edge directions of A and B. An edge pair is
+ *        tested only if the arcs of the two edges on the Gauss maps of A
+ *        and -B intersect, i.e., the pair makes a face of the Minkowski
+ *        difference. The other pairs can not give a separating axis that
+ *        is not found by the face normals.
+ *
+ *        The test stops at the first separating axis found, and the axis
+ *        is kept in SATCache per pair of bodies. The next test for the pair
+ *        tries it first, and for the bodies that move a little per frame
+ *        the separated pairs are then rejected by one axis.
+ *
+ *        A transform (q, p) maps a point x in LCS of the body to
+ *        q.rotate(x) + p in the world. q must be a unit quaternion.
+ *
+ * @reference "The Separating Axis Test between Convex Polyhedra",
+ *            D. Gregorius, Game Developers Conference 2013
+ */
+namespace Makena {
+
+using namespace std;
+
+
+/** @class SATShape
+ *
+ *  @brief the features of a convex manifold in flat arrays for the
+ *         separating axis test, made once per manifold.
+ */
+class SATShape {
+
+  public:
+
+    inline SATShape();
+    inline ~SATShape();
+
+    /** @brief makes the arrays from the manifold.
+     *
+     *  @param m (in): convex and closed manifold such as the one made by
+     *                 Manifold::findConvexHull(). It is not referred to
+     *                 after this call.
+     *
+     *  @return false if the manifold is empty or not closed.
+     */
+    bool build(Manifold& m);
+
+    inline void clear();
+
+    inline bool empty() const;
+
+    inline long numVertices() const;
+    inline long numFaces()    const;
+    inline long numEdges()    const;
+
+  private:
+
+    vector<Vec3> mVertices;
+
+    /** @brief outward unit normals from Manifold::getFaceNormalsOriginal()
+     *         and the offsets of the planes of the faces along them.
+     */
+    vector<Vec3>   mFaceNormals;
+    vector<double> mFaceOffsets;
+
+    /** @brief the source and the direction of each edge. */
+    vector<Vec3> mEdgePoints;
+    vector<Vec3> mEdgeDirections;
+
+    /** @brief the normals of the two incident faces of each edge, i.e.,
+     *         the end points of the arc of the edge on the Gauss map.
+     *         The first is the face on the left of the direction.
+     */
+    vector<Vec3> mEdgeNormals1;
+    vector<Vec3> mEdgeNormals2;
+
+    /** @brief the mean of the vertices used to orient the edge axes. */
+    Vec3         mCenter;
+
+  friend class SATTester;
+
+#ifdef UNIT_TESTS
+  friend class SATShapeTests;
+#endif
+
+};
+
+
+/** @class SATCache
+ *
+ *  @brief the separating axis of the last test for a pair of bodies, kept
+ *         by the caller. It refers to the features of the SATShapes, and
+ *         it must be cleared when they are rebuilt.
+ */
+class SATCache {
+
+  public:
+
+    enum AxisType {
+        AXIS_NONE,
+        AXIS_FACE_A,
+        AXIS_FACE_B,
+        AXIS_EDGES
+    };
+
+    inline SATCache();
+
+    /** @brief forgets the axis. */
+    inline void clear();
+
+    inline enum AxisType type() const;
+
+  private:
+
+    enum AxisType mType;
+
+    /** @brief the face of A or B, or the edge of A. */
+    long          mIndex1;
+
+    /** @brief the edge of B. */
+    long          mIndex2;
+
+  friend class SATTester;
+};
+
+
+class SATTester {
+
+  public:
+
+    inline SATTester();
+    inline ~SATTester();
+
+    /** @brief tests if the two convex bodies overlap.
+     *
+     *  @param A     (in):     shape of the body A
+     *
+     *  @param qA    (in):     rotation of A
+     *
+     *  @param pA    (in):     translation of A
+     *
+     *  @param B     (in):     shape of the body B
+     *
+     *  @param qB    (in):     rotation of B
+     *
+     *  @param pB    (in):     translation of B
+     *
+     *  @param cache (in/out): the separating axis of the previous test for
+     *                         the pair. It is updated to the separating
+     *                         axis found, or cleared if they overlap.
+     *
+     *  @return true if the bodies overlap or touch.
+     */
+    bool overlap(
+        const SATShape&   A,
+        const Quaternion& qA,
+        const Vec3&       pA,
+        const SATShape&   B,
+        const Quaternion& qB,
+        const Vec3&       pB,
+        SATCache&         cache
+    );
+
+    /** @brief number of the calls to overlap(). */
+    inline long numTests()          const;
+
+    /** @brief number of the tests answered by the cached axis. */
+    inline long numCacheHits()      const;
+
+    /** @brief number of the face normals tested. */
+    inline long numFaceAxesTested() const;
+
+    /** @brief number of the edge pairs that passed the Gauss map test and
+     *         whose axes are tested.
+     */
+    inline long numEdgeAxesTested() const;
+
+    /** @brief number of the edge pairs rejected by the Gauss map test. */
+    inline long numEdgePairsPruned() const;
+
+    inline void clearStats();
+
+  private:
+
+    /** @brief sets the transform of B into LCS of A. */
+    void setBodies(
+        const SATShape&   A,
+        const Quaternion& qA,
+        const Vec3&       pA,
+        const SATShape&   B,
+        const Quaternion& qB,
+        const Vec3&       pB
+    );
+
+    /** @brief separation of B from A along the face normal of A. */
+    inline double separationFaceA(const long index) const;
+
+    /** @brief separation of A from B along the face normal of B. */
+    inline double separationFaceB(const long index) const;
+
+    /** @brief separation along the cross product of the edges.
+     *         It is meaningful only if the pair passes isMinkowskiFace().
+     */
+    double separationEdges(const long indexA, const long indexB) const;
+
+    /** @brief the Gauss map test on the edge of A and the edge of B whose
+     *         arcs are negated.
+     */
+    inline bool isMinkowskiFace(const long indexA, const long indexB) const;
+
+    /** @brief the separation along the cached axis. */
+    double separationCached(const SATCache& cache) const;
+
+    const SATShape* mA;
+    const SATShape* mB;
+
+    /** @brief rotation and translation of B in LCS of A. */
+    Mat3x3          mRotBA;
+    Vec3            mPosBA;
+
+    /** @brief rotation of A in LCS of B. */
+    Mat3x3          mRotAB;
+    Vec3            mPosAB;
+
+    /** @brief work memory of the edges of B in LCS of A kept for reuse. */
+    vector<Vec3>    mEdgePointsB;
+    vector<Vec3>    mEdgeDirectionsB;
+    vector<Vec3>    mEdgeNormals1B;
+    vector<Vec3>    mEdgeNormals2B;
+
+    long            mNumTests;
+    long            mNumCacheHits;
+    long            mNumFaceAxesTested;
+    long            mNumEdgeAxesTested;
+    long            mNumEdgePairsPruned;
+
+#ifdef UNIT_TESTS
+  friend class SATTesterTests;
+#endif
+
+};
+
+
+inline SATShape::SATShape(){;}
+
+
+inline SATShape::~SATShape(){;}
+
+
+inline void SATShape::clear()
+{
+    mVertices.clear();
+    mFaceNormals.clear();
+    mFaceOffsets.clear();
+    mEdgePoints.clear();
+    mEdgeDirections.clear();
+    mEdgeNormals1.clear();
+    mEdgeNormals2.clear();
+}
+
+
+inline bool SATShape::empty() const
+{
+    return mVertices.empty();
+}
+
+
+inline long SATShape::numVertices() const
+{
+    return (long)mVertices.size();
+}
+
+
+inline long SATShape::numFaces() const
+{
+    return (long)mFaceNormals.size();
+}
+
+
+inline long SATShape::numEdges() const
+{
+    return (long)mEdgeDirections.size();
+}
+
+
+inline SATCache::SATCache():mType(AXIS_NONE),mIndex1(0),mIndex2(0){;}
+
+
+inline void SATCache::clear()
+{
+    mType = AXIS_NONE;
+}
+
+
+inline enum SATCache::AxisType SATCache::type() const
+{
+    return mType;
+}
+
+
+inline SATTester::SATTester():
+    mA(nullptr),
+    mB(nullptr),
+    mNumTests(0),
+    mNumCacheHits(0),
+    mNumFaceAxesTested(0),
+    mNumEdgeAxesTested(0),
+    mNumEdgePairsPruned(0){;}
+
+
+inline SATTester::~SATTester(){;}
+
+
+inline long SATTester::numTests() const
+{
+    return mNumTests;
+}
+
+
+inline long SATTester::numCacheHits() const
+{
+    return mNumCacheHits;
+}
+
+
+inline long SATTester::numFaceAxesTested() const
+{
+    return mNumFaceAxesTested;
+}
+
+
+inline long SATTester::numEdgeAxesTested() const
+{
+    return mNumEdgeAxesTested;
+}
+
+
+inline long SATTester::numEdgePairsPruned() const
+{
+    return mNumEdgePairsPruned;
+}
+
+
+inline void SATTester::clearStats()
+{
+    mNumTests           = 0;
+    mNumCacheHits       = 0;
+    mNumFaceAxesTested  = 0;
+    mNumEdgeAxesTested  = 0;
+    mNumEdgePairsPruned = 0;
+}
+
+
+inline double SATTester::separationFaceA(const long index) const
+{
+    // The lowest vertex of B along the normal in LCS of B.
+    const Vec3&  n = mA->mFaceNormals[index];
+    const Vec3   d = mRotAB * n;
+    double       lowest = HUGE_VAL;
+    for (auto& v : mB->mVertices) {
+        lowest = min(lowest, d.dot(v));
+    }
+    return lowest + n.dot(mPosBA) - mA->mFaceOffsets[index];
+}
+
+
+inline double SATTester::separationFaceB(const long index) const
+{
+    const Vec3&  n = mB->mFaceNormals[index];
+    const Vec3   d = mRotBA * n;
+    double       lowest = HUGE_VAL;
+    for (auto& v : mA->mVertices) {
+        lowest = min(lowest, d.dot(v));
+    }
+    return lowest + n.dot(mPosAB) - mB->mFaceOffsets[index];
+}
+
+
+inline bool SATTester::isMinkowskiFace(
+    const long indexA,
+    const long indexB
+) const {
+    // The arc a-b of A and the arc c-d of -B intersect on the unit sphere
+    // if a and b are on the opposite sides of the plane of c-d, c and d
+    // are on the opposite sides of the plane of a-b, and they are on the
+    // same hemisphere.
+    const Vec3&  a   = mA->mEdgeNormals1[indexA];
+    const Vec3&  b   = mA->mEdgeNormals2[indexA];
+    const Vec3   c   = mEdgeNormals1B[indexB] * -1.0;
+    const Vec3   d   = mEdgeNormals2B[indexB] * -1.0;
+    const Vec3   bxa = b.cross(a);
+    const Vec3   dxc = d.cross(c);
+    const double cba = c.dot(bxa);
+    const double dba = d.dot(bxa);
+    const double adc = a.dot(dxc);
+    const double bdc = b.dot(dxc);
+    return cba * dba < 0.0 && adc * bdc < 0.0 && cba * bdc > 0.0;
+}
+
+
+}// namespace Makena
+
+
+#endif/*_MAKENA_SEPARATING_AXIS_HPP_*/
@@ -11,6 +11,7 @@
 -(instancetype) init;
 -(void) findConvexHull:          (const simd_float3 * const) points numPoints: (const int) numPoints;
 -(void) findOrientedBoundingBox: (const simd_float3 * const) points numPoints: (const int) numPoints;
+-(void) findGridConvexHull:      (const simd_int3 * const) cells numCells: (const int) numCells origin: (const simd_float3) origin pitch: (const float) pitch;
  
 -(const simd_float3*) vertices;
 -(long) numVertices;
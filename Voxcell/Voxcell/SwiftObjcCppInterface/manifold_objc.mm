@@ -2,6 +2,7 @@
 #import "manifold_objc.h"
 #include "manifold.hpp"
 #include "orienting_bounding_box.hpp"
+#include "compact_mesh.hpp"
 #include <vector>
 #include <map>
 #include <algorithm>
@@ -83,15 +84,43 @@ using namespace Makena;
 }
 
 
+-(void) findGridConvexHull:(const simd_int3 *const) cells
+                   numCells:(const int) numCells
+                     origin:(const simd_float3) origin
+                      pitch:(const float) pitch
+{
+    _mVertices.clear();
+    _mFacesIndexAroundVerticesCCW.clear();
+    _mFaceNormals.clear();
+    _mVerticesIndexAroundFacesCCW.clear();
+
+    Manifold convex_hull;
+    enum predicate pred;
+    vector< array<long, 3> > vec;
+
+    for ( int i = 0; i < numCells; i++ ) {
+
+        vec.push_back( { (long)(cells[i].x), (long)(cells[i].y), (long)(cells[i].z) } );
+    }
+
+    convex_hull.findConvexHullOfGridCells( vec, Vec3( origin.x, origin.y, origin.z ), pitch, pred );
+    NSLog(@"pred: %d", pred);
+
+    if (pred != NONE ) {
+        return;
+    }
+
+    [self generateVerticesAndFacesListForSwiftFor: convex_hull ];
+}
+
+
 -(void) generateVerticesAndFacesListForSwiftFor:(Manifold&) m
 {
-    auto vits = m.vertices();
-    auto fits = m.faces();
+    CompactMesh mesh;
+    mesh.build( m );
 
-    long index = 0;
-    for (auto vit = vits.first; vit != vits.second; vit++ ) {
-        (*vit)->userUtil = index++;
-        const auto& p = (*vit)->pLCS();
+    for ( uint32_t v = 0; v < mesh.numVertices(); v++ ) {
+        const auto& p = mesh.position( v );
         simd_float3 pf;
         pf.x = p.x();
         pf.y = p.y();
@@ -99,21 +128,19 @@ using namespace Makena;
         _mVertices.push_back(pf);
     }
 
-    index = 0;
-    for (auto fit = fits.first; fit != fits.second; fit++ ) {
-        (*fit)->userUtil = index++;
-        const auto& n = (*fit)->nLCS();
+    for ( uint32_t f = 0; f < mesh.numFaces(); f++ ) {
+        const auto& n = mesh.faceNormal( f );
         simd_float3 nf;
         nf.x = n.x();
         nf.y = n.y();
         nf.z = n.z();
         _mFaceNormals.push_back( nf );
 
+        const auto heBegin = mesh.faceHalfEdgesBegin( f );
+        const auto heEnd   = mesh.faceHalfEdgesEnd( f );
+
         // take the 1st halfedge as the tangent direction.
-        const auto he0it = (*fit)->halfEdges().begin();
-        const auto src0it = (*(*he0it))->src();
-        const auto dst0it = (*(*he0it))->dst();
-        auto t = (*dst0it)->pLCS() - (*src0it)->pLCS();
+        auto t = mesh.position( mesh.dst( heBegin ) ) - mesh.position( mesh.src( heBegin ) );
         t.normalize();
         simd_float3 tf; // tangent
         tf.x = (float)t.x();
@@ -130,22 +157,17 @@ using namespace Makena;
 
         // Pass 1: find the center point of the face
         Vec3 centerPoint( 0.0, 0.0, 0.0 );
-        int  numOfPoints = 0;
-        for ( auto heit = (*fit)->halfEdges().begin(); heit != (*fit)->halfEdges().end(); heit++ ) {
+        for ( auto he = heBegin; he != heEnd; he++ ) {
 
-            const auto dstit = (*(*heit))->dst();
-            centerPoint += ((*dstit)->pLCS());
-            numOfPoints++;
+            centerPoint += mesh.position( mesh.dst( he ) );
         }
-        centerPoint.scale( 1.0 / (double)numOfPoints );
+        centerPoint.scale( 1.0 / (double)mesh.faceDegree( f ) );
 
         // Pass 2: find the max xy-extents from center to the points in the face-local coordinates.
         float maxOrthoDist = 0.0;
-        for ( auto heit = (*fit)->halfEdges().begin(); heit != (*fit)->halfEdges().end(); heit++ ) {
-
-            const auto dstit = (*(*heit))->dst();
+        for ( auto he = heBegin; he != heEnd; he++ ) {
 
-            Vec3 centerToDstLCS = ((*dstit)->pLCS()) - centerPoint;
+            Vec3 centerToDstLCS = mesh.position( mesh.dst( he ) ) - centerPoint;
             Vec2 centerToDstFCS( t.dot(centerToDstLCS), bt.dot(centerToDstLCS) );
             maxOrthoDist = std::max(maxOrthoDist, abs((float)centerToDstFCS.x()));
             maxOrthoDist = std::max(maxOrthoDist, abs((float)centerToDstFCS.y()));
@@ -155,13 +177,13 @@ using namespace Makena;
         vector<long> verticesIndexAroundFaceCCW;
         vector<simd_float2> textureCoordinatesAroundFacesCCW;
 
-        for ( auto heit = (*fit)->halfEdges().begin(); heit != (*fit)->halfEdges().end(); heit++ ) {
+        for ( auto he = heBegin; he != heEnd; he++ ) {
 
-            const auto dstit = (*(*heit))->dst();
+            const auto dst = mesh.dst( he );
 
-            verticesIndexAroundFaceCCW.push_back( (*dstit)->userUtil );
+            verticesIndexAroundFaceCCW.push_back( dst );
 
-            Vec3 centerToDstLCS = ((*dstit)->pLCS()) - centerPoint;
+            Vec3 centerToDstLCS = mesh.position( dst ) - centerPoint;
             Vec2 centerToDstFCS( t.dot(centerToDstLCS), bt.dot(centerToDstLCS) );
             simd_float2 dstFCS;
             dstFCS.x = 0.5 + 0.5 * centerToDstFCS.x() / maxOrthoDist;
@@ -177,17 +199,11 @@ using namespace Makena;
         _mTextureCoordinatesAroundFacesCCW.emplace_back( textureCoordinatesAroundFacesCCW );
     }
 
-    for (auto vit = vits.first; vit != vits.second; vit++ ) {
+    vector<uint32_t> faces;
+    for ( uint32_t v = 0; v < mesh.numVertices(); v++ ) {
 
-        vector<long> facesIndexAroundVertexCCW;
-        for ( auto heit = (*vit)->halfEdges().begin(); heit != (*vit)->halfEdges().end(); heit++ ) {
-            const auto srcit = (*(*heit))->src();
-            if ( (*vit)->userUtil == (*srcit)->userUtil ) {
-                const auto fit = (*(*heit))->face();
-                facesIndexAroundVertexCCW.push_back( (*fit)->userUtil );
-            }
-        }
-        _mFacesIndexAroundVerticesCCW.emplace_back(facesIndexAroundVertexCCW);
+        mesh.facesAroundVertex( v, faces );
+        _mFacesIndexAroundVerticesCCW.emplace_back( faces.begin(), faces.end() );
     }
 /*
     NSLog(@"Vertex points");